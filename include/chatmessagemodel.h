@@ -0,0 +1,94 @@
+#ifndef CHATMESSAGEMODEL_H
+#define CHATMESSAGEMODEL_H
+
+#include "timerwheel.h"
+#include <QAbstractListModel>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QQmlEngine>
+#include <qqmlregistration.h>
+#include <functional>
+#include <queue>
+#include <vector>
+
+// Chat rows for the overlay. Rows past maxMessages are dropped from the top,
+// and with a lifetime set every row expires through a single timer wheel that
+// removes everything due on a tick in one batch. Delegates compute their fade
+// from expiresAt and now, which only changes while a row is fading.
+class ChatMessageModel : public QAbstractListModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+
+    Q_PROPERTY(int maxMessages READ maxMessages WRITE setMaxMessages NOTIFY maxMessagesChanged)
+    Q_PROPERTY(int lifetime READ lifetime WRITE setLifetime NOTIFY lifetimeChanged)
+    Q_PROPERTY(int fadeDuration READ fadeDuration WRITE setFadeDuration NOTIFY fadeDurationChanged)
+    Q_PROPERTY(qint64 now READ now NOTIFY nowChanged)
+
+public:
+    enum Roles {
+        UsernameRole = Qt::UserRole + 1,
+        MessageRole,
+        ColorRole,
+        ExpiresAtRole
+    };
+
+    explicit ChatMessageModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int maxMessages() const;
+    void setMaxMessages(int maxMessages);
+    int lifetime() const;
+    void setLifetime(int seconds);
+    int fadeDuration() const;
+    void setFadeDuration(int milliseconds);
+    qint64 now() const;
+
+    Q_INVOKABLE void append(const QString& username, const QString& message, const QString& color);
+    Q_INVOKABLE void clear();
+
+signals:
+    void maxMessagesChanged();
+    void lifetimeChanged();
+    void fadeDurationChanged();
+    void nowChanged();
+
+private slots:
+    void onTick();
+
+private:
+    struct Message
+    {
+        quint64 id;
+        QString username;
+        QString message;
+        QString color;
+        qint64 expiresAt;   // Milliseconds on m_clock, 0 keeps the row
+    };
+
+    using Deadline = std::pair<qint64, quint64>;   // expiresAt, id
+
+    void scheduleTick();
+    void removeExpired(QList<quint64> ids);
+    void trimToMax();
+    int rowOf(quint64 id) const;
+    bool isFading(qint64 now);
+    qint64 earliestExpiry();
+
+    QList<Message> m_messages;
+    quint64 m_nextId;
+    int m_maxMessages;
+    int m_lifetime;
+    int m_fadeDuration;
+    qint64 m_now;
+    QElapsedTimer m_clock;
+    TimerWheel m_wheel;
+    // Earliest deadline on top, entries of removed rows are dropped when they reach it
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> m_deadlines;
+    QTimer* m_tickTimer;
+};
+
+#endif // CHATMESSAGEMODEL_H
@@ -0,0 +1,47 @@
+#ifndef CHATRELAY_H
+#define CHATRELAY_H
+
+#include <QObject>
+#include <QList>
+
+class QFile;
+class QLocalServer;
+class QLocalSocket;
+
+// Writes every chat message to stdout and/or local socket clients, encoded
+// once per message as newline-delimited JSON or a stream of CBOR maps.
+class ChatRelay : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Format {
+        Json,
+        Cbor
+    };
+
+    explicit ChatRelay(Format format, QObject* parent = nullptr);
+    ~ChatRelay();
+
+    bool writeToStdout();
+    bool listen(const QString& name);
+
+    static QByteArray encode(Format format, const QString& username, const QString& message,
+                             const QString& color, qint64 timestamp);
+
+public slots:
+    void relayMessage(const QString& username, const QString& message, const QString& color);
+
+private slots:
+    void onNewConnection();
+
+private:
+    void write(const QByteArray& data);
+
+    Format m_format;
+    QFile* m_stdout;
+    QLocalServer* m_server;
+    QList<QLocalSocket*> m_clients;
+};
+
+#endif // CHATRELAY_H
@@ -0,0 +1,78 @@
+#ifndef CHATSERVER_H
+#define CHATSERVER_H
+
+#include <QObject>
+#include <QHash>
+#include <QQueue>
+#include <QQmlEngine>
+#include <qqmlregistration.h>
+
+class QTcpServer;
+class QTcpSocket;
+
+// Local HTTP server for OBS browser sources: "/" serves the chat page and
+// "/events" streams messages as Server-Sent Events. Each message is encoded
+// once and the same bytes are queued for every subscriber.
+class ChatServer : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_SINGLETON
+
+    Q_PROPERTY(bool running READ isRunning NOTIFY runningChanged)
+    Q_PROPERTY(int port READ port NOTIFY runningChanged)
+    Q_PROPERTY(int clientCount READ clientCount NOTIFY clientCountChanged)
+    Q_PROPERTY(QString errorString READ errorString NOTIFY errorStringChanged)
+
+public:
+    // Events held back for a slow client before the oldest ones are dropped
+    static constexpr qsizetype MaxQueuedEvents = 256;
+
+    static ChatServer* create(QQmlEngine* qmlEngine, QJSEngine* jsEngine);
+    static ChatServer* instance();
+
+    bool isRunning() const;
+    int port() const;
+    int clientCount() const;
+    QString errorString() const;
+
+    // Backlog of the slowest subscriber and events dropped so far, for diagnostics
+    qsizetype longestQueue() const;
+    qint64 droppedEvents() const;
+
+public slots:
+    bool start(int port);
+    void stop();
+    void broadcastMessage(const QString& username, const QString& message, const QString& color);
+
+signals:
+    void runningChanged();
+    void clientCountChanged();
+    void errorStringChanged();
+
+private slots:
+    void onNewConnection();
+
+private:
+    struct Subscriber
+    {
+        QQueue<QByteArray> queue;
+        qint64 dropped = 0;
+    };
+
+    explicit ChatServer(QObject* parent = nullptr);
+    void readRequest(QTcpSocket* socket);
+    void respond(QTcpSocket* socket, const QByteArray& status, const QByteArray& contentType, const QByteArray& body);
+    void subscribe(QTcpSocket* socket);
+    void enqueue(QTcpSocket* socket, Subscriber& subscriber, const QByteArray& event);
+    void flush(QTcpSocket* socket, Subscriber& subscriber);
+    void removeSocket(QTcpSocket* socket);
+
+    static ChatServer* s_instance;
+    QTcpServer* m_server;
+    QString m_errorString;
+    QHash<QTcpSocket*, QByteArray> m_requests;
+    QHash<QTcpSocket*, Subscriber> m_subscribers;
+};
+
+#endif // CHATSERVER_H
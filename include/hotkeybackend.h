@@ -0,0 +1,33 @@
+#ifndef HOTKEYBACKEND_H
+#define HOTKEYBACKEND_H
+
+#include <QObject>
+
+// Platform side of ShortcutManager: grabs global key combinations and reports
+// them back as Qt modifiers/keys, so the rest of the app never sees native codes.
+class HotkeyBackend : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit HotkeyBackend(QObject *parent = nullptr) : QObject(parent) {}
+
+    // Picks the native backend for the running platform
+    static HotkeyBackend* createDefault(QObject *parent = nullptr);
+
+    virtual bool registerHotkey(int modifiers, int key) = 0;
+    virtual void unregisterAll() = 0;
+
+    // Synthesizes the key combination, returns false when the platform can't
+    virtual bool sendShortcut(int modifiers, int key)
+    {
+        Q_UNUSED(modifiers)
+        Q_UNUSED(key)
+        return false;
+    }
+
+signals:
+    void hotkeyActivated(int modifiers, int key);
+};
+
+#endif // HOTKEYBACKEND_H
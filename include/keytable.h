@@ -0,0 +1,143 @@
+#ifndef KEYTABLE_H
+#define KEYTABLE_H
+
+#include <QString>
+#include <QtGlobal>
+#include <algorithm>
+#include <array>
+
+// Compile-time key lookup tables. Every table is an array of entries with an
+// int qtKey field, sorted once at compile time so lookups are a binary search.
+namespace KeyTable {
+
+struct KeyInfo
+{
+    int qtKey;
+    int baseKey;      // Unshifted key on a US layout (Shift+1 = ! -> Key_1)
+    const char* text;
+};
+
+struct NativeKey
+{
+    int qtKey;
+    quint32 code;
+};
+
+template <typename Entry, std::size_t N>
+constexpr std::array<Entry, N> sorted(std::array<Entry, N> entries)
+{
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.qtKey < b.qtKey;
+    });
+    return entries;
+}
+
+template <typename Entry, std::size_t N>
+constexpr const Entry* find(const std::array<Entry, N>& table, int qtKey)
+{
+    auto it = std::lower_bound(table.begin(), table.end(), qtKey, [](const Entry& entry, int key) {
+        return entry.qtKey < key;
+    });
+    return (it != table.end() && it->qtKey == qtKey) ? &*it : nullptr;
+}
+
+inline constexpr auto keys = sorted(std::to_array<KeyInfo>({
+    { Qt::Key_Space, Qt::Key_Space, "Space" },
+    { Qt::Key_Return, Qt::Key_Return, "Return" },
+    { Qt::Key_Enter, Qt::Key_Enter, "Enter" },
+    { Qt::Key_Tab, Qt::Key_Tab, "Tab" },
+    { Qt::Key_Escape, Qt::Key_Escape, "Escape" },
+    { Qt::Key_Backspace, Qt::Key_Backspace, "Backspace" },
+    { Qt::Key_Delete, Qt::Key_Delete, "Delete" },
+    { Qt::Key_Insert, Qt::Key_Insert, "Insert" },
+    { Qt::Key_Home, Qt::Key_Home, "Home" },
+    { Qt::Key_End, Qt::Key_End, "End" },
+    { Qt::Key_PageUp, Qt::Key_PageUp, "Page Up" },
+    { Qt::Key_PageDown, Qt::Key_PageDown, "Page Down" },
+    { Qt::Key_Left, Qt::Key_Left, "Left" },
+    { Qt::Key_Right, Qt::Key_Right, "Right" },
+    { Qt::Key_Up, Qt::Key_Up, "Up" },
+    { Qt::Key_Down, Qt::Key_Down, "Down" },
+
+    // Function keys
+    { Qt::Key_F1, Qt::Key_F1, "F1" },
+    { Qt::Key_F2, Qt::Key_F2, "F2" },
+    { Qt::Key_F3, Qt::Key_F3, "F3" },
+    { Qt::Key_F4, Qt::Key_F4, "F4" },
+    { Qt::Key_F5, Qt::Key_F5, "F5" },
+    { Qt::Key_F6, Qt::Key_F6, "F6" },
+    { Qt::Key_F7, Qt::Key_F7, "F7" },
+    { Qt::Key_F8, Qt::Key_F8, "F8" },
+    { Qt::Key_F9, Qt::Key_F9, "F9" },
+    { Qt::Key_F10, Qt::Key_F10, "F10" },
+    { Qt::Key_F11, Qt::Key_F11, "F11" },
+    { Qt::Key_F12, Qt::Key_F12, "F12" },
+
+    // Special characters that might appear when using Shift
+    { Qt::Key_Exclam, Qt::Key_1, "1" },
+    { Qt::Key_At, Qt::Key_2, "2" },
+    { Qt::Key_NumberSign, Qt::Key_3, "3" },
+    { Qt::Key_Dollar, Qt::Key_4, "4" },
+    { Qt::Key_Percent, Qt::Key_5, "5" },
+    { Qt::Key_AsciiCircum, Qt::Key_6, "6" },
+    { Qt::Key_Ampersand, Qt::Key_7, "7" },
+    { Qt::Key_Asterisk, Qt::Key_8, "8" },
+    { Qt::Key_ParenLeft, Qt::Key_9, "9" },
+    { Qt::Key_ParenRight, Qt::Key_0, "0" },
+
+    // Other common symbols
+    { Qt::Key_Minus, Qt::Key_Minus, "-" },
+    { Qt::Key_Underscore, Qt::Key_Minus, "-" },
+    { Qt::Key_Equal, Qt::Key_Equal, "=" },
+    { Qt::Key_Plus, Qt::Key_Equal, "=" },
+    { Qt::Key_BracketLeft, Qt::Key_BracketLeft, "[" },
+    { Qt::Key_BraceLeft, Qt::Key_BracketLeft, "[" },
+    { Qt::Key_BracketRight, Qt::Key_BracketRight, "]" },
+    { Qt::Key_BraceRight, Qt::Key_BracketRight, "]" },
+    { Qt::Key_Backslash, Qt::Key_Backslash, "\\" },
+    { Qt::Key_Bar, Qt::Key_Backslash, "\\" },
+    { Qt::Key_Semicolon, Qt::Key_Semicolon, ";" },
+    { Qt::Key_Colon, Qt::Key_Semicolon, ";" },
+    { Qt::Key_Apostrophe, Qt::Key_Apostrophe, "'" },
+    { Qt::Key_QuoteDbl, Qt::Key_Apostrophe, "'" },
+    { Qt::Key_Comma, Qt::Key_Comma, "," },
+    { Qt::Key_Less, Qt::Key_Comma, "," },
+    { Qt::Key_Period, Qt::Key_Period, "." },
+    { Qt::Key_Greater, Qt::Key_Period, "." },
+    { Qt::Key_Slash, Qt::Key_Slash, "/" },
+    { Qt::Key_Question, Qt::Key_Slash, "/" },
+    { Qt::Key_QuoteLeft, Qt::Key_QuoteLeft, "`" },
+    { Qt::Key_AsciiTilde, Qt::Key_QuoteLeft, "`" },
+}));
+
+// Maps shifted characters back to the physical key, letters and digits map to themselves
+inline int baseKey(int qtKey)
+{
+    if ((qtKey >= Qt::Key_A && qtKey <= Qt::Key_Z) || (qtKey >= Qt::Key_0 && qtKey <= Qt::Key_9)) {
+        return qtKey;
+    }
+    const KeyInfo* info = find(keys, qtKey);
+    return info ? info->baseKey : 0;
+}
+
+inline QString text(int qtKey)
+{
+    if (qtKey >= Qt::Key_A && qtKey <= Qt::Key_Z) {
+        return QChar('A' + (qtKey - Qt::Key_A));
+    }
+    if (qtKey >= Qt::Key_0 && qtKey <= Qt::Key_9) {
+        return QChar('0' + (qtKey - Qt::Key_0));
+    }
+    if (const KeyInfo* info = find(keys, qtKey)) {
+        return QString::fromLatin1(info->text);
+    }
+    // For any unknown keys, try to show something meaningful
+    if (qtKey >= 32 && qtKey <= 126) {
+        return QChar(qtKey);
+    }
+    return QString("Key_%1").arg(qtKey);
+}
+
+} // namespace KeyTable
+
+#endif // KEYTABLE_H
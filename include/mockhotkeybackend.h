@@ -0,0 +1,33 @@
+#ifndef MOCKHOTKEYBACKEND_H
+#define MOCKHOTKEYBACKEND_H
+
+#include "hotkeybackend.h"
+#include <QList>
+#include <QPair>
+
+// Backend without any OS integration: it records registrations and only fires
+// when trigger() is called. Used for headless tests and unsupported platforms.
+class MockHotkeyBackend : public HotkeyBackend
+{
+    Q_OBJECT
+
+public:
+    explicit MockHotkeyBackend(QObject *parent = nullptr);
+
+    bool registerHotkey(int modifiers, int key) override;
+    void unregisterAll() override;
+    bool sendShortcut(int modifiers, int key) override;
+
+    QList<QPair<int, int>> registeredHotkeys() const;
+    QList<QPair<int, int>> sentShortcuts() const;
+
+public slots:
+    // Behaves like the OS reporting a key press, registered combos only
+    bool trigger(int modifiers, int key);
+
+private:
+    QList<QPair<int, int>> m_hotkeys;
+    QList<QPair<int, int>> m_sent;
+};
+
+#endif // MOCKHOTKEYBACKEND_H
@@ -3,7 +3,8 @@
 
 #include <QObject>
 #include <QQmlEngine>
-#include <windows.h>
+
+class HotkeyBackend;
 
 class ShortcutManager : public QObject
 {
@@ -12,33 +13,33 @@ class ShortcutManager : public QObject
     QML_SINGLETON
 
 public:
+    // Takes ownership of backend, the platform default is created when none is given
+    explicit ShortcutManager(HotkeyBackend *backend = nullptr, QObject *parent = nullptr);
+    ~ShortcutManager();
+
     static ShortcutManager* create(QQmlEngine *qmlEngine, QJSEngine *jsEngine);
     static ShortcutManager* instance();
 
     Q_INVOKABLE QString getShortcutText(int modifiers, int key);
     Q_INVOKABLE void executeShortcut(int modifiers, int key);
 
-    void installHook();
-    void uninstallHook();
+    HotkeyBackend* backend() const;
+
+    void registerShortcuts();
+    void unregisterShortcuts();
 
 signals:
     void toggleOverlay();
 
-private:
-    explicit ShortcutManager(QObject *parent = nullptr);
-    ~ShortcutManager();
+private slots:
+    void onHotkeyActivated(int modifiers, int key);
 
+private:
     static ShortcutManager* s_instance;
-    static LRESULT CALLBACK lowLevelKeyboardProc(int nCode, WPARAM wParam, LPARAM lParam);
-
-    void processKeyPress(int vkCode, int modifiers);
-    UINT qtKeyToVirtualKey(int qtKey);
-
-    HHOOK m_keyboardHook;
 
-    static bool s_ctrlPressed;
-    static bool s_shiftPressed;
-    static bool s_altPressed;
+    HotkeyBackend* m_backend;
+    int m_toggleModifiers;
+    int m_toggleKey;
 };
 
 #endif // SHORTCUTMANAGER_H
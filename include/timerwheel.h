@@ -0,0 +1,51 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <QList>
+#include <array>
+
+// Hierarchical timer wheel: three levels of 64 slots. Level 0 slots are one
+// tick wide, each higher level slot covers a full turn of the level below and
+// is cascaded down when that level wraps. Scheduling is O(1) and advancing
+// only touches the slots of the elapsed ticks.
+class TimerWheel
+{
+public:
+    explicit TimerWheel(qint64 tickMs);
+
+    void schedule(quint64 id, qint64 deadlineMs);
+    // Removes an entry, deadlineMs must be the one it was scheduled with
+    bool cancel(quint64 id, qint64 deadlineMs);
+    // Processes every tick up to nowMs and returns the ids that expired
+    QList<quint64> advance(qint64 nowMs);
+    void clear();
+
+    bool isEmpty() const;
+    qsizetype size() const;
+    // Earliest time advance() has work to do: an expiry or a cascade of a
+    // non-empty slot. -1 when the wheel is empty.
+    qint64 nextDeadline() const;
+    qint64 tickMs() const;
+
+private:
+    static constexpr int SlotBits = 6;
+    static constexpr int SlotCount = 1 << SlotBits;
+    static constexpr int LevelCount = 3;
+
+    struct Entry
+    {
+        quint64 id;
+        qint64 expiryTick;
+    };
+
+    void insert(const Entry& entry);
+    static bool removeFrom(QList<Entry>& slot, quint64 id);
+    void cascade(int level, qint64 tick);
+
+    qint64 m_tickMs;
+    qint64 m_currentTick;
+    qsizetype m_size;
+    std::array<std::array<QList<Entry>, SlotCount>, LevelCount> m_levels;
+};
+
+#endif // TIMERWHEEL_H
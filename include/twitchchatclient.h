@@ -23,6 +23,9 @@ public:
     bool isConnected() const;
     QString currentChannel() const;
 
+    // Feeds raw IRC bytes through the parser as if they came from the socket
+    void processData(const QByteArray& data);
+
 public slots:
     void connectToChannel(const QString& channel, const QString& token);
     void disconnect();
@@ -52,6 +55,7 @@ private:
     QTimer* m_pingTimer;
     QString m_channel;
     QString m_token;
+    QByteArray m_readBuffer;
     bool m_connected;
 };
 
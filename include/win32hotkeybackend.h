@@ -0,0 +1,43 @@
+#ifndef WIN32HOTKEYBACKEND_H
+#define WIN32HOTKEYBACKEND_H
+
+#include "hotkeybackend.h"
+#include <QList>
+#include <windows.h>
+
+class Win32HotkeyBackend : public HotkeyBackend
+{
+    Q_OBJECT
+
+public:
+    explicit Win32HotkeyBackend(QObject *parent = nullptr);
+    ~Win32HotkeyBackend();
+
+    bool registerHotkey(int modifiers, int key) override;
+    void unregisterAll() override;
+    bool sendShortcut(int modifiers, int key) override;
+
+    static UINT qtKeyToVirtualKey(int qtKey);
+
+private:
+    struct Hotkey
+    {
+        int modifiers;
+        int key;
+        UINT vkCode;
+    };
+
+    static Win32HotkeyBackend* s_instance;
+    static LRESULT CALLBACK lowLevelKeyboardProc(int nCode, WPARAM wParam, LPARAM lParam);
+
+    void installHook();
+    void uninstallHook();
+    bool processKeyDown(UINT vkCode);
+    void updateModifier(UINT vkCode, bool pressed);
+
+    HHOOK m_keyboardHook;
+    QList<Hotkey> m_hotkeys;
+    int m_modifiers;
+};
+
+#endif // WIN32HOTKEYBACKEND_H
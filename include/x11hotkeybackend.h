@@ -0,0 +1,40 @@
+#ifndef X11HOTKEYBACKEND_H
+#define X11HOTKEYBACKEND_H
+
+#include "hotkeybackend.h"
+#include <QAbstractNativeEventFilter>
+#include <QList>
+
+// Grabs registered combinations on the root window with XGrabKey, the X server
+// only delivers those key presses instead of every keystroke.
+class X11HotkeyBackend : public HotkeyBackend, public QAbstractNativeEventFilter
+{
+    Q_OBJECT
+
+public:
+    explicit X11HotkeyBackend(QObject *parent = nullptr);
+    ~X11HotkeyBackend();
+
+    static bool isAvailable();
+
+    bool registerHotkey(int modifiers, int key) override;
+    void unregisterAll() override;
+
+    bool nativeEventFilter(const QByteArray &eventType, void *message, qintptr *result) override;
+
+private:
+    struct Hotkey
+    {
+        int modifiers;
+        int key;
+        quint32 keycode;
+        quint32 nativeModifiers;
+    };
+
+    bool grab(const Hotkey &hotkey);
+    void ungrab(const Hotkey &hotkey);
+
+    QList<Hotkey> m_hotkeys;
+};
+
+#endif // X11HOTKEYBACKEND_H
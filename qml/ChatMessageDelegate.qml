@@ -0,0 +1,29 @@
+import QtQuick
+import QtQuick.Controls.Universal
+
+// One chat line, shared by the overlay's chat list and bench_headless
+Rectangle {
+    id: messageDel
+    required property var model
+    // Taken from the ChatMessageModel so the delegate doesn't depend on the list's ids
+    property double now: 0
+    property int fadeDuration: 0
+    property int textSize: 15
+
+    height: messageText.implicitHeight + 10
+    color: "transparent"
+    // Re-evaluated only when now changes, which it does while a row fades
+    opacity: messageDel.model.expiresAt > 0 && messageDel.fadeDuration > 0 ?
+                 Math.max(0, Math.min(1, (messageDel.model.expiresAt - messageDel.now) / messageDel.fadeDuration)) :
+                 1
+
+    Label {
+        id: messageText
+        anchors.fill: parent
+        anchors.margins: 5
+        text: "<font color='" + messageDel.model.color + "'><b>" + messageDel.model.username + ":</b></font> " + messageDel.model.message
+        font.pixelSize: messageDel.textSize
+        wrapMode: Text.WordWrap
+        textFormat: Text.RichText
+    }
+}
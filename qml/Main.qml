@@ -30,11 +30,11 @@ ApplicationWindow {
         if (UserSettings.channelName !== "" && UserSettings.token !== "") {
             TwitchChatClient.connectToChannel(UserSettings.channelName, UserSettings.token)
         }
-    }
 
-    BusyIndicator {
-        opacity: 0
-        running: true
+        if (UserSettings.browserSourceEnabled) {
+            // Don't retry a port that is taken on every launch
+            UserSettings.browserSourceEnabled = ChatServer.start(UserSettings.browserSourcePort)
+        }
     }
 
     function showOverlay() {
@@ -166,28 +166,14 @@ ApplicationWindow {
                 model: chatModel
                 spacing: 2
 
-                delegate: Rectangle {
-                    id: messageDel
+                delegate: ChatMessageDelegate {
                     width: chatView.width
-                    height: messageText.implicitHeight + 10
-                    color: "transparent"
-                    required property var model
-
-                    Label {
-                        id: messageText
-                        anchors.fill: parent
-                        anchors.margins: 5
-                        text: "<font color='" + messageDel.model.color + "'><b>" + messageDel.model.username + ":</b></font> " + messageDel.model.message
-                        font.pixelSize: UserSettings.chatTextSize
-                        wrapMode: Text.WordWrap
-                        textFormat: Text.RichText
-                    }
+                    now: chatModel.now
+                    fadeDuration: chatModel.fadeDuration
+                    textSize: UserSettings.chatTextSize
                 }
 
                 onCountChanged: {
-                    if (count > 100) {
-                        chatModel.remove(0, count - 100)
-                    }
                     // Delay scroll to next frame so ListView can update its contentHeight
                     Qt.callLater(positionViewAtEnd)
                 }
@@ -300,8 +286,11 @@ ApplicationWindow {
         }
     }
 
-    ListModel {
+    ChatMessageModel {
         id: chatModel
+        maxMessages: 100
+        lifetime: UserSettings.messageLifetime
+        fadeDuration: UserSettings.fadeMessages ? 1000 : 0
     }
 
     SettingsDialog {
@@ -325,19 +314,11 @@ ApplicationWindow {
         target: TwitchChatClient
 
         function onMessageReceived(username, message, color) {
-            chatModel.append({
-                "username": username,
-                "message": message,
-                "color": color
-            })
+            chatModel.append(username, message, color)
         }
 
         function onConnectionError(error) {
-            chatModel.append({
-                "username": "System",
-                "message": "Connection error: " + error,
-                "color": "#FF4444"
-            })
+            chatModel.append("System", "Connection error: " + error, "#FF4444")
         }
     }
 }
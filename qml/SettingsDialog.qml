@@ -122,5 +122,78 @@ CustomWindow {
                 onValueChanged: UserSettings.overlayOpacity = value
             }
         }
+
+        RowLayout {
+            Label {
+                text: "Message lifetime (seconds, 0 keeps them)"
+                Layout.fillWidth: true
+            }
+
+            SpinBox {
+                from: 0
+                to: 600
+                editable: true
+                value: UserSettings.messageLifetime
+                onValueChanged: UserSettings.messageLifetime = value
+            }
+        }
+
+        RowLayout {
+            enabled: UserSettings.messageLifetime > 0
+
+            Label {
+                text: "Fade out expiring messages"
+                Layout.fillWidth: true
+            }
+
+            Switch {
+                checked: UserSettings.fadeMessages
+                onToggled: UserSettings.fadeMessages = checked
+            }
+        }
+
+        RowLayout {
+            Label {
+                text: "Browser source server"
+                Layout.fillWidth: true
+            }
+
+            SpinBox {
+                from: 1024
+                to: 65535
+                editable: true
+                enabled: !ChatServer.running
+                value: UserSettings.browserSourcePort
+                onValueChanged: UserSettings.browserSourcePort = value
+                textFromValue: function(value) { return value.toString() }
+            }
+
+            Switch {
+                checked: ChatServer.running
+                onToggled: {
+                    if (checked) {
+                        UserSettings.browserSourceEnabled = ChatServer.start(UserSettings.browserSourcePort)
+                    } else {
+                        UserSettings.browserSourceEnabled = false
+                        ChatServer.stop()
+                    }
+                    // Toggling assigns checked, follow the server state again
+                    checked = Qt.binding(function() { return ChatServer.running })
+                }
+            }
+        }
+
+        Label {
+            visible: !ChatServer.running && ChatServer.errorString !== ""
+            text: "Browser source server failed: " + ChatServer.errorString
+            color: "#FF4444"
+        }
+
+        Label {
+            visible: ChatServer.running
+            text: "OBS browser source: http://localhost:" + ChatServer.port + "/ (" + ChatServer.clientCount + " connected)"
+            font.italic: true
+            opacity: 0.7
+        }
     }
 }
@@ -11,4 +11,8 @@ Settings {
     property int windowHeight: 600
     property int chatTextSize: 15
     property real overlayOpacity: 0.1
+    property bool browserSourceEnabled: false
+    property int browserSourcePort: 8420
+    property int messageLifetime: 0
+    property bool fadeMessages: true
 }
@@ -0,0 +1,253 @@
+#include "chatmessagemodel.h"
+#include <algorithm>
+#include <limits>
+
+// Wheel resolution, also the frame interval while a row fades
+static constexpr int TickMs = 50;
+
+ChatMessageModel::ChatMessageModel(QObject* parent)
+    : QAbstractListModel(parent)
+    , m_nextId(0)
+    , m_maxMessages(100)
+    , m_lifetime(0)
+    , m_fadeDuration(0)
+    , m_now(0)
+    , m_wheel(TickMs)
+    , m_tickTimer(new QTimer(this))
+{
+    m_clock.start();
+    // Armed for the next deadline or fade frame only, idle chat has no wake-ups
+    m_tickTimer->setSingleShot(true);
+    m_tickTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_tickTimer, &QTimer::timeout, this, &ChatMessageModel::onTick);
+}
+
+int ChatMessageModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_messages.size();
+}
+
+QVariant ChatMessageModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_messages.size()) {
+        return QVariant();
+    }
+
+    const Message& message = m_messages.at(index.row());
+    switch (role) {
+    case UsernameRole: return message.username;
+    case MessageRole: return message.message;
+    case ColorRole: return message.color;
+    case ExpiresAtRole: return message.expiresAt;
+    default: return QVariant();
+    }
+}
+
+QHash<int, QByteArray> ChatMessageModel::roleNames() const
+{
+    return {
+        { UsernameRole, "username" },
+        { MessageRole, "message" },
+        { ColorRole, "color" },
+        { ExpiresAtRole, "expiresAt" }
+    };
+}
+
+int ChatMessageModel::maxMessages() const
+{
+    return m_maxMessages;
+}
+
+void ChatMessageModel::setMaxMessages(int maxMessages)
+{
+    if (m_maxMessages == maxMessages) {
+        return;
+    }
+    m_maxMessages = maxMessages;
+    trimToMax();
+    emit maxMessagesChanged();
+}
+
+int ChatMessageModel::lifetime() const
+{
+    return m_lifetime;
+}
+
+void ChatMessageModel::setLifetime(int seconds)
+{
+    // Only applies to new messages, rows already shown keep their deadline
+    if (m_lifetime == seconds) {
+        return;
+    }
+    m_lifetime = seconds;
+    emit lifetimeChanged();
+}
+
+int ChatMessageModel::fadeDuration() const
+{
+    return m_fadeDuration;
+}
+
+void ChatMessageModel::setFadeDuration(int milliseconds)
+{
+    if (m_fadeDuration == milliseconds) {
+        return;
+    }
+    m_fadeDuration = milliseconds;
+    scheduleTick();
+    emit fadeDurationChanged();
+}
+
+qint64 ChatMessageModel::now() const
+{
+    return m_now;
+}
+
+void ChatMessageModel::append(const QString& username, const QString& message, const QString& color)
+{
+    qint64 expiresAt = 0;
+    if (m_lifetime > 0) {
+        // Catch the wheel up to the clock before filing a new deadline, nothing
+        // is due yet since the timer is armed for the next deadline
+        qint64 now = m_clock.elapsed();
+        QList<quint64> expired = m_wheel.advance(now);
+        if (!expired.isEmpty()) {
+            removeExpired(std::move(expired));
+        }
+        expiresAt = now + m_lifetime * 1000;
+        m_wheel.schedule(m_nextId, expiresAt);
+        m_deadlines.push({ expiresAt, m_nextId });
+    }
+
+    beginInsertRows(QModelIndex(), m_messages.size(), m_messages.size());
+    m_messages.append({ m_nextId++, username, message, color, expiresAt });
+    endInsertRows();
+
+    trimToMax();
+    if (expiresAt > 0) {
+        scheduleTick();
+    }
+}
+
+void ChatMessageModel::clear()
+{
+    beginResetModel();
+    m_messages.clear();
+    endResetModel();
+    m_wheel.clear();
+    m_deadlines = {};
+    m_tickTimer->stop();
+}
+
+void ChatMessageModel::onTick()
+{
+    qint64 now = m_clock.elapsed();
+    QList<quint64> expired = m_wheel.advance(now);
+
+    // Delegates only re-evaluate their opacity while something is fading
+    if (isFading(now) || !expired.isEmpty()) {
+        m_now = now;
+        emit nowChanged();
+    }
+
+    if (!expired.isEmpty()) {
+        removeExpired(std::move(expired));
+    }
+
+    scheduleTick();
+}
+
+void ChatMessageModel::scheduleTick()
+{
+    if (m_wheel.isEmpty()) {
+        m_tickTimer->stop();
+        return;
+    }
+
+    qint64 now = m_clock.elapsed();
+    qint64 next = m_wheel.nextDeadline();
+    if (m_fadeDuration > 0) {
+        qint64 fadeStart = earliestExpiry() - m_fadeDuration;
+        next = fadeStart <= now ? now + TickMs : qMin(next, fadeStart);
+    }
+
+    int interval = int(qBound<qint64>(0, next - now, std::numeric_limits<int>::max()));
+    // Keep an earlier wake-up, re-arming on every message of a burst would keep pushing it back
+    if (m_tickTimer->isActive() && m_tickTimer->remainingTime() <= interval) {
+        return;
+    }
+    m_tickTimer->start(interval);
+}
+
+void ChatMessageModel::removeExpired(QList<quint64> ids)
+{
+    // Ids grow with the row index, so expired rows form a few contiguous runs
+    std::sort(ids.begin(), ids.end());
+
+    QList<QPair<int, int>> runs;
+    for (quint64 id : std::as_const(ids)) {
+        int row = rowOf(id);
+        if (row < 0) {
+            // Already pushed out by maxMessages
+            continue;
+        }
+
+        if (!runs.isEmpty() && runs.last().second == row - 1) {
+            runs.last().second = row;
+        } else {
+            runs.append({ row, row });
+        }
+    }
+
+    // Back to front so earlier runs keep their row numbers
+    for (auto run = runs.crbegin(); run != runs.crend(); ++run) {
+        beginRemoveRows(QModelIndex(), run->first, run->second);
+        m_messages.remove(run->first, run->second - run->first + 1);
+        endRemoveRows();
+    }
+}
+
+void ChatMessageModel::trimToMax()
+{
+    int excess = m_messages.size() - m_maxMessages;
+    if (m_maxMessages <= 0 || excess <= 0) {
+        return;
+    }
+
+    // Pushed out rows give their deadline back so it doesn't wake the timer
+    for (int row = 0; row < excess; ++row) {
+        const Message& message = m_messages.at(row);
+        if (message.expiresAt > 0) {
+            m_wheel.cancel(message.id, message.expiresAt);
+        }
+    }
+
+    beginRemoveRows(QModelIndex(), 0, excess - 1);
+    m_messages.remove(0, excess);
+    endRemoveRows();
+    scheduleTick();
+}
+
+int ChatMessageModel::rowOf(quint64 id) const
+{
+    // Ids grow with the row index
+    auto it = std::lower_bound(m_messages.cbegin(), m_messages.cend(), id, [](const Message& message, quint64 id) {
+        return message.id < id;
+    });
+    return (it != m_messages.cend() && it->id == id) ? int(it - m_messages.cbegin()) : -1;
+}
+
+bool ChatMessageModel::isFading(qint64 now)
+{
+    return m_fadeDuration > 0 && earliestExpiry() - now < m_fadeDuration;
+}
+
+qint64 ChatMessageModel::earliestExpiry()
+{
+    // Rows that expired or were trimmed leave their entry behind, each is
+    // popped once, so a burst of appends costs O(log n) per row
+    while (!m_deadlines.empty() && rowOf(m_deadlines.top().second) < 0) {
+        m_deadlines.pop();
+    }
+    return m_deadlines.empty() ? std::numeric_limits<qint64>::max() : m_deadlines.top().first;
+}
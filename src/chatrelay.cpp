@@ -0,0 +1,117 @@
+#include "chatrelay.h"
+#include <QCborMap>
+#include <QCborValue>
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <cstdio>
+
+// A client that stops reading is dropped once this much output is pending
+static constexpr qint64 MaxPendingBytes = 4 * 1024 * 1024;
+
+ChatRelay::ChatRelay(Format format, QObject* parent)
+    : QObject(parent)
+    , m_format(format)
+    , m_stdout(nullptr)
+    , m_server(nullptr)
+{
+}
+
+ChatRelay::~ChatRelay()
+{
+    if (m_stdout) {
+        m_stdout->flush();
+    }
+}
+
+bool ChatRelay::writeToStdout()
+{
+    if (m_stdout) {
+        return true;
+    }
+
+    m_stdout = new QFile(this);
+    if (!m_stdout->open(stdout, QIODevice::WriteOnly)) {
+        qWarning() << "Failed to open stdout:" << m_stdout->errorString();
+        delete m_stdout;
+        m_stdout = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool ChatRelay::listen(const QString& name)
+{
+    if (!m_server) {
+        m_server = new QLocalServer(this);
+        connect(m_server, &QLocalServer::newConnection, this, &ChatRelay::onNewConnection);
+    }
+
+    QLocalServer::removeServer(name);
+    if (!m_server->listen(name)) {
+        qWarning() << "Failed to listen on" << name << m_server->errorString();
+        return false;
+    }
+
+    qDebug() << "Relaying chat on local socket" << m_server->fullServerName();
+    return true;
+}
+
+QByteArray ChatRelay::encode(Format format, const QString& username, const QString& message,
+                             const QString& color, qint64 timestamp)
+{
+    if (format == Cbor) {
+        QCborMap map;
+        map.insert(QStringLiteral("timestamp"), timestamp);
+        map.insert(QStringLiteral("username"), username);
+        map.insert(QStringLiteral("message"), message);
+        map.insert(QStringLiteral("color"), color);
+        return map.toCborValue().toCbor();
+    }
+
+    QJsonObject object;
+    object.insert("timestamp", timestamp);
+    object.insert("username", username);
+    object.insert("message", message);
+    object.insert("color", color);
+    return QJsonDocument(object).toJson(QJsonDocument::Compact) + '\n';
+}
+
+void ChatRelay::relayMessage(const QString& username, const QString& message, const QString& color)
+{
+    write(encode(m_format, username, message, color, QDateTime::currentMSecsSinceEpoch()));
+}
+
+void ChatRelay::onNewConnection()
+{
+    while (QLocalSocket* client = m_server->nextPendingConnection()) {
+        m_clients.append(client);
+        connect(client, &QLocalSocket::disconnected, this, [this, client]() {
+            m_clients.removeOne(client);
+            client->deleteLater();
+        });
+    }
+}
+
+void ChatRelay::write(const QByteArray& data)
+{
+    if (m_stdout) {
+        m_stdout->write(data);
+        m_stdout->flush();
+    }
+
+    // abort() emits disconnected, which edits m_clients
+    const QList<QLocalSocket*> clients = m_clients;
+    for (QLocalSocket* client : clients) {
+        if (client->bytesToWrite() > MaxPendingBytes) {
+            qWarning() << "Dropping relay client that stopped reading";
+            client->abort();
+            continue;
+        }
+        client->write(data);
+    }
+}
@@ -0,0 +1,273 @@
+#include "chatserver.h"
+#include "chatrelay.h"
+#include "twitchchatclient.h"
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+ChatServer* ChatServer::s_instance = nullptr;
+
+// Stop handing bytes to a socket once this much is waiting in its write buffer
+static constexpr qint64 SocketHighWater = 64 * 1024;
+static constexpr qsizetype MaxRequestSize = 8 * 1024;
+
+// The Host header a browser sends for a page it loaded from this server. Anything
+// else is another origin reaching the port, e.g. through DNS rebinding.
+static bool isLocalHost(const QByteArray& head, int port)
+{
+    const QByteArray suffix = ':' + QByteArray::number(port);
+    const QList<QByteArray> lines = head.split('\n');
+    for (qsizetype i = 1; i < lines.size(); ++i) {
+        const QByteArray& line = lines[i];
+        qsizetype colon = line.indexOf(':');
+        if (colon < 0 || line.left(colon).trimmed().toLower() != "host") {
+            continue;
+        }
+        QByteArray host = line.mid(colon + 1).trimmed().toLower();
+        return host == "localhost" + suffix || host == "127.0.0.1" + suffix;
+    }
+    return false;
+}
+
+ChatServer* ChatServer::create(QQmlEngine* qmlEngine, QJSEngine* jsEngine)
+{
+    Q_UNUSED(qmlEngine)
+    Q_UNUSED(jsEngine)
+
+    return instance();
+}
+
+ChatServer* ChatServer::instance()
+{
+    if (!s_instance) {
+        s_instance = new ChatServer();
+    }
+    return s_instance;
+}
+
+ChatServer::ChatServer(QObject* parent)
+    : QObject(parent)
+    , m_server(new QTcpServer(this))
+{
+    connect(m_server, &QTcpServer::newConnection, this, &ChatServer::onNewConnection);
+    connect(TwitchChatClient::instance(), &TwitchChatClient::messageReceived, this, &ChatServer::broadcastMessage);
+}
+
+bool ChatServer::isRunning() const
+{
+    return m_server->isListening();
+}
+
+int ChatServer::port() const
+{
+    return m_server->serverPort();
+}
+
+int ChatServer::clientCount() const
+{
+    return m_subscribers.size();
+}
+
+QString ChatServer::errorString() const
+{
+    return m_errorString;
+}
+
+qsizetype ChatServer::longestQueue() const
+{
+    qsizetype longest = 0;
+    for (const Subscriber& subscriber : m_subscribers) {
+        longest = qMax(longest, subscriber.queue.size());
+    }
+    return longest;
+}
+
+qint64 ChatServer::droppedEvents() const
+{
+    qint64 dropped = 0;
+    for (const Subscriber& subscriber : m_subscribers) {
+        dropped += subscriber.dropped;
+    }
+    return dropped;
+}
+
+bool ChatServer::start(int port)
+{
+    if (m_server->isListening()) {
+        if (m_server->serverPort() == port) {
+            return true;
+        }
+        stop();
+    }
+
+    if (!m_server->listen(QHostAddress::LocalHost, port)) {
+        m_errorString = QString("Port %1: %2").arg(port).arg(m_server->errorString());
+        qWarning() << "Failed to start browser source server on" << m_errorString;
+        emit errorStringChanged();
+        return false;
+    }
+
+    qInfo().noquote() << "Browser source available at" << QString("http://localhost:%1/").arg(m_server->serverPort());
+    if (!m_errorString.isEmpty()) {
+        m_errorString.clear();
+        emit errorStringChanged();
+    }
+    emit runningChanged();
+    return true;
+}
+
+void ChatServer::stop()
+{
+    if (!m_server->isListening()) {
+        return;
+    }
+
+    m_server->close();
+    const QList<QTcpSocket*> sockets = m_requests.keys() + m_subscribers.keys();
+    for (QTcpSocket* socket : sockets) {
+        socket->abort();
+    }
+    emit runningChanged();
+}
+
+void ChatServer::broadcastMessage(const QString& username, const QString& message, const QString& color)
+{
+    if (m_subscribers.isEmpty()) {
+        return;
+    }
+
+    // JSON lines end with '\n', one more terminates the event
+    QByteArray event = "data: "
+                       + ChatRelay::encode(ChatRelay::Json, username, message, color, QDateTime::currentMSecsSinceEpoch())
+                       + '\n';
+
+    for (auto it = m_subscribers.begin(); it != m_subscribers.end(); ++it) {
+        enqueue(it.key(), it.value(), event);
+    }
+}
+
+void ChatServer::onNewConnection()
+{
+    while (QTcpSocket* socket = m_server->nextPendingConnection()) {
+        m_requests.insert(socket, QByteArray());
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            readRequest(socket);
+        });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            removeSocket(socket);
+        });
+    }
+}
+
+void ChatServer::readRequest(QTcpSocket* socket)
+{
+    auto it = m_requests.find(socket);
+    if (it == m_requests.end()) {
+        // Subscribers have nothing more to say, ignore whatever they send
+        socket->readAll();
+        return;
+    }
+
+    it.value() += socket->readAll();
+    QByteArray& request = it.value();
+    if (!request.contains("\r\n\r\n")) {
+        if (request.size() > MaxRequestSize) {
+            respond(socket, "431 Request Header Fields Too Large", "text/plain", "Request too large\n");
+        }
+        return;
+    }
+
+    // Only the request line and Host matter: GET <path> HTTP/1.x
+    QByteArray head = request.left(request.indexOf("\r\n\r\n"));
+    QList<QByteArray> requestLine = head.left(head.indexOf("\r\n")).split(' ');
+    m_requests.erase(it);
+
+    if (requestLine.size() < 2 || requestLine[0] != "GET") {
+        respond(socket, "405 Method Not Allowed", "text/plain", "Method not allowed\n");
+        return;
+    }
+    if (!isLocalHost(head, port())) {
+        respond(socket, "403 Forbidden", "text/plain", "Unexpected Host\n");
+        return;
+    }
+
+    // OBS and browsers may add a query string, it carries nothing we use
+    QByteArray path = requestLine[1];
+    qsizetype query = path.indexOf('?');
+    if (query >= 0) {
+        path.truncate(query);
+    }
+    if (path == "/" || path == "/index.html") {
+        QFile page(":/web/index.html");
+        page.open(QIODevice::ReadOnly);
+        respond(socket, "200 OK", "text/html; charset=utf-8", page.readAll());
+    } else if (path == "/events") {
+        subscribe(socket);
+    } else {
+        respond(socket, "404 Not Found", "text/plain", "Not found\n");
+    }
+}
+
+void ChatServer::respond(QTcpSocket* socket, const QByteArray& status, const QByteArray& contentType, const QByteArray& body)
+{
+    m_requests.remove(socket);
+    socket->write("HTTP/1.1 " + status + "\r\n"
+                  "Content-Type: " + contentType + "\r\n"
+                  "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+                  "Connection: close\r\n"
+                  "\r\n" + body);
+    socket->disconnectFromHost();
+}
+
+void ChatServer::subscribe(QTcpSocket* socket)
+{
+    socket->write("HTTP/1.1 200 OK\r\n"
+                  "Content-Type: text/event-stream\r\n"
+                  "Cache-Control: no-cache\r\n"
+                  "Connection: keep-alive\r\n"
+                  "\r\n");
+
+    m_subscribers.insert(socket, Subscriber());
+    connect(socket, &QTcpSocket::bytesWritten, this, [this, socket]() {
+        auto it = m_subscribers.find(socket);
+        if (it != m_subscribers.end()) {
+            flush(socket, it.value());
+        }
+    });
+    emit clientCountChanged();
+}
+
+void ChatServer::enqueue(QTcpSocket* socket, Subscriber& subscriber, const QByteArray& event)
+{
+    if (subscriber.queue.isEmpty() && socket->bytesToWrite() < SocketHighWater) {
+        socket->write(event);
+        return;
+    }
+
+    // A slow client only loses its own oldest messages, it never holds up the others
+    if (subscriber.queue.size() >= MaxQueuedEvents) {
+        subscriber.queue.dequeue();
+        if (subscriber.dropped++ == 0) {
+            qWarning() << "Browser source client" << socket->peerPort() << "is too slow, dropping messages";
+        }
+    }
+    subscriber.queue.enqueue(event);
+}
+
+void ChatServer::flush(QTcpSocket* socket, Subscriber& subscriber)
+{
+    while (!subscriber.queue.isEmpty() && socket->bytesToWrite() < SocketHighWater) {
+        socket->write(subscriber.queue.dequeue());
+    }
+}
+
+void ChatServer::removeSocket(QTcpSocket* socket)
+{
+    m_requests.remove(socket);
+    if (m_subscribers.remove(socket)) {
+        emit clientCountChanged();
+    }
+    socket->deleteLater();
+}
@@ -0,0 +1,27 @@
+#include "hotkeybackend.h"
+#include "mockhotkeybackend.h"
+#include <QDebug>
+#include <QGuiApplication>
+
+#if defined(Q_OS_WIN)
+#include "win32hotkeybackend.h"
+#elif defined(Q_OS_LINUX)
+#include "x11hotkeybackend.h"
+#endif
+
+HotkeyBackend* HotkeyBackend::createDefault(QObject *parent)
+{
+#if defined(Q_OS_WIN)
+    return new Win32HotkeyBackend(parent);
+#elif defined(Q_OS_LINUX)
+    if (X11HotkeyBackend::isAvailable()) {
+        return new X11HotkeyBackend(parent);
+    }
+    qWarning() << "Global hotkeys need an X11 session and a Qt built with xcb-xlib, platform is"
+               << QGuiApplication::platformName();
+    return new MockHotkeyBackend(parent);
+#else
+    qWarning() << "Global hotkeys are not supported on this platform";
+    return new MockHotkeyBackend(parent);
+#endif
+}
@@ -1,8 +1,150 @@
 #include <QGuiApplication>
 #include <QQmlApplicationEngine>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QLoggingCategory>
+#include <QSettings>
+#include <cstring>
+#include "chatrelay.h"
+#include "chatserver.h"
+#include "twitchchatclient.h"
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <cstdio>
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+static bool hasHeadlessFlag(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef Q_OS_WIN
+// The executable uses the GUI subsystem, so a console launch gets no stdout or
+// stderr. Attach to the parent's console for the streams that weren't redirected,
+// a `> file` or pipe already has a valid handle and is kept. Started without a
+// console (e.g. from a service), output only goes where it was redirected.
+static void attachParentConsole()
+{
+    if (AttachConsole(ATTACH_PARENT_PROCESS)) {
+        if (_fileno(stdout) < 0) {
+            freopen("CONOUT$", "w", stdout);
+        }
+        if (_fileno(stderr) < 0) {
+            freopen("CONOUT$", "w", stderr);
+        }
+    }
+    // CBOR is binary and JSON lines end in \n, keep the CRT from adding \r
+    if (_fileno(stdout) >= 0) {
+        _setmode(_fileno(stdout), _O_BINARY);
+    }
+}
+#endif
+
+// Runs only the IRC client and relays parsed messages, no QML engine is created
+static int runHeadless(int argc, char *argv[])
+{
+#ifdef Q_OS_WIN
+    attachParentConsole();
+#endif
+    QCoreApplication app(argc, argv);
+    app.setOrganizationName("Odizinne");
+    app.setApplicationName("TwitchChatOverlay");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Relays Twitch chat as a message stream");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "headless", "Run without a window, relaying chat to stdout or a local socket. Exits with status 2 when the chat connection is lost." },
+        { "channel", "Channel to join, defaults to the saved setting.", "name" },
+        { "token", "OAuth token, defaults to the saved setting.", "token" },
+        { "format", "Output format: json (newline-delimited) or cbor.", "format", "json" },
+        { "socket", "Serve the stream on a local socket instead of stdout.", "name" },
+        { "serve", "Serve the browser source page on this localhost port instead of stdout.", "port" },
+        { "verbose", "Keep debug output on stderr." },
+    });
+    parser.process(app);
+
+    ChatRelay::Format format;
+    if (parser.value("format") == "json") {
+        format = ChatRelay::Json;
+    } else if (parser.value("format") == "cbor") {
+        format = ChatRelay::Cbor;
+    } else {
+        qCritical() << "Unknown format" << parser.value("format");
+        return 1;
+    }
+
+    if (!parser.isSet("verbose")) {
+        // The client logs every raw IRC line, which dominates the cost at high message rates
+        QLoggingCategory::setFilterRules("*.debug=false");
+    }
+
+    QSettings settings;
+    QString channel = parser.isSet("channel") ? parser.value("channel") : settings.value("channelName").toString();
+    QString token = parser.isSet("token") ? parser.value("token") : settings.value("token").toString();
+    if (channel.isEmpty() || token.isEmpty()) {
+        qCritical() << "A channel and token are required, pass --channel and --token or save them in the overlay settings";
+        return 1;
+    }
+
+    int servePort = 0;
+    if (parser.isSet("serve")) {
+        bool ok = false;
+        servePort = parser.value("serve").toInt(&ok);
+        if (!ok || servePort < 1 || servePort > 65535) {
+            qCritical() << "Invalid --serve port" << parser.value("serve") << "expected 1-65535";
+            return 1;
+        }
+    }
+
+    // The relay only encodes when it has somewhere to write, --serve alone leaves it out
+    ChatRelay relay(format);
+    bool relayOutput = parser.isSet("socket") || !parser.isSet("serve");
+    if (parser.isSet("socket") && !relay.listen(parser.value("socket"))) {
+        return 1;
+    }
+    if (relayOutput && !parser.isSet("socket") && !relay.writeToStdout()) {
+        return 1;
+    }
+    if (servePort != 0 && !ChatServer::instance()->start(servePort)) {
+        return 1;
+    }
+
+    TwitchChatClient* client = TwitchChatClient::instance();
+    if (relayOutput) {
+        QObject::connect(client, &TwitchChatClient::messageReceived, &relay, &ChatRelay::relayMessage);
+    }
+    // No reconnect here: losing the connection exits with status 2 so a supervisor
+    // (systemd, a shell loop) restarts the relay and sees that it failed
+    QObject::connect(client, &TwitchChatClient::connectionError, &app, [](const QString& error) {
+        qCritical() << "Connection error:" << error;
+        QCoreApplication::exit(2);
+    });
+    QObject::connect(client, &TwitchChatClient::connectedChanged, &app, [client]() {
+        if (!client->isConnected()) {
+            qCritical() << "Disconnected from Twitch IRC";
+            QCoreApplication::exit(2);
+        }
+    });
+    client->connectToChannel(channel, token);
+
+    return app.exec();
+}
 
 int main(int argc, char *argv[])
 {
+    if (hasHeadlessFlag(argc, argv)) {
+        return runHeadless(argc, argv);
+    }
+
     qputenv("QT_QUICK_BACKEND", "software");
     QGuiApplication app(argc, argv);
     app.setOrganizationName("Odizinne");
@@ -0,0 +1,42 @@
+#include "mockhotkeybackend.h"
+
+MockHotkeyBackend::MockHotkeyBackend(QObject *parent)
+    : HotkeyBackend(parent)
+{
+}
+
+bool MockHotkeyBackend::registerHotkey(int modifiers, int key)
+{
+    m_hotkeys.append({ modifiers, key });
+    return true;
+}
+
+void MockHotkeyBackend::unregisterAll()
+{
+    m_hotkeys.clear();
+}
+
+bool MockHotkeyBackend::sendShortcut(int modifiers, int key)
+{
+    m_sent.append({ modifiers, key });
+    return true;
+}
+
+QList<QPair<int, int>> MockHotkeyBackend::registeredHotkeys() const
+{
+    return m_hotkeys;
+}
+
+QList<QPair<int, int>> MockHotkeyBackend::sentShortcuts() const
+{
+    return m_sent;
+}
+
+bool MockHotkeyBackend::trigger(int modifiers, int key)
+{
+    if (!m_hotkeys.contains(QPair<int, int>(modifiers, key))) {
+        return false;
+    }
+    emit hotkeyActivated(modifiers, key);
+    return true;
+}
@@ -0,0 +1,158 @@
+#include "timerwheel.h"
+
+TimerWheel::TimerWheel(qint64 tickMs)
+    : m_tickMs(tickMs)
+    , m_currentTick(0)
+    , m_size(0)
+{
+}
+
+void TimerWheel::schedule(quint64 id, qint64 deadlineMs)
+{
+    // Round up so nothing expires before its deadline, the current tick is already done
+    qint64 expiryTick = (deadlineMs + m_tickMs - 1) / m_tickMs;
+    insert({ id, qMax(expiryTick, m_currentTick + 1) });
+    ++m_size;
+}
+
+bool TimerWheel::cancel(quint64 id, qint64 deadlineMs)
+{
+    qint64 expiryTick = qMax((deadlineMs + m_tickMs - 1) / m_tickMs, m_currentTick);
+
+    // An entry sits in the slot of its expiry tick on one of the levels
+    for (int level = 0; level < LevelCount; ++level) {
+        if (removeFrom(m_levels[level][(expiryTick >> (level * SlotBits)) & (SlotCount - 1)], id)) {
+            --m_size;
+            return true;
+        }
+    }
+
+    // Deadlines past the wheel range are parked in the furthest level 2 slot
+    // and past deadlines were moved to the next tick, look everywhere for those
+    for (auto& level : m_levels) {
+        for (QList<Entry>& slot : level) {
+            if (removeFrom(slot, id)) {
+                --m_size;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool TimerWheel::removeFrom(QList<Entry>& slot, quint64 id)
+{
+    for (qsizetype i = 0; i < slot.size(); ++i) {
+        if (slot.at(i).id == id) {
+            slot.remove(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void TimerWheel::insert(const Entry& entry)
+{
+    qint64 expiryTick = qMax(entry.expiryTick, m_currentTick);
+    qint64 delta = expiryTick - m_currentTick;
+
+    for (int level = 0; level < LevelCount; ++level) {
+        int shift = level * SlotBits;
+        if (delta < (qint64(1) << (shift + SlotBits)) || level == LevelCount - 1) {
+            if (level == LevelCount - 1) {
+                // Past the wheel range, park in the furthest slot and re-file on cascade
+                expiryTick = qMin(expiryTick, m_currentTick + (qint64(1) << (shift + SlotBits)) - 1);
+            }
+            m_levels[level][(expiryTick >> shift) & (SlotCount - 1)].append(entry);
+            return;
+        }
+    }
+}
+
+void TimerWheel::cascade(int level, qint64 tick)
+{
+    QList<Entry> entries;
+    entries.swap(m_levels[level][(tick >> (level * SlotBits)) & (SlotCount - 1)]);
+    for (const Entry& entry : std::as_const(entries)) {
+        insert(entry);
+    }
+}
+
+QList<quint64> TimerWheel::advance(qint64 nowMs)
+{
+    QList<quint64> expired;
+    qint64 targetTick = nowMs / m_tickMs;
+
+    while (m_currentTick < targetTick) {
+        if (m_size == 0) {
+            m_currentTick = targetTick;
+            break;
+        }
+
+        qint64 tick = ++m_currentTick;
+        // Re-file higher levels first, entries due on this tick land in its level 0 slot
+        if ((tick & (SlotCount - 1)) == 0) {
+            if (((tick >> SlotBits) & (SlotCount - 1)) == 0) {
+                cascade(2, tick);
+            }
+            cascade(1, tick);
+        }
+
+        QList<Entry>& slot = m_levels[0][tick & (SlotCount - 1)];
+        for (const Entry& entry : std::as_const(slot)) {
+            expired.append(entry.id);
+        }
+        m_size -= slot.size();
+        slot.clear();
+    }
+
+    return expired;
+}
+
+void TimerWheel::clear()
+{
+    for (auto& level : m_levels) {
+        for (QList<Entry>& slot : level) {
+            slot.clear();
+        }
+    }
+    m_size = 0;
+}
+
+bool TimerWheel::isEmpty() const
+{
+    return m_size == 0;
+}
+
+qsizetype TimerWheel::size() const
+{
+    return m_size;
+}
+
+qint64 TimerWheel::nextDeadline() const
+{
+    if (m_size == 0) {
+        return -1;
+    }
+
+    // First non-empty slot after the current one on each level. A higher
+    // level slot needs a wake-up when it cascades, at the start of its span.
+    qint64 next = -1;
+    for (int level = 0; level < LevelCount; ++level) {
+        int shift = level * SlotBits;
+        qint64 span = m_currentTick >> shift;
+        for (int i = 1; i <= SlotCount; ++i) {
+            if (!m_levels[level][(span + i) & (SlotCount - 1)].isEmpty()) {
+                qint64 tick = (span + i) << shift;
+                next = next < 0 ? tick : qMin(next, tick);
+                break;
+            }
+        }
+    }
+    return next * m_tickMs;
+}
+
+qint64 TimerWheel::tickMs() const
+{
+    return m_tickMs;
+}
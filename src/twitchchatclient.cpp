@@ -110,6 +110,7 @@ void TwitchChatClient::onSocketDisconnected()
     qDebug() << "Disconnected from Twitch IRC";
     m_connected = false;
     m_pingTimer->stop();
+    m_readBuffer.clear();
     emit connectedChanged();
 }
 
@@ -121,13 +122,23 @@ void TwitchChatClient::onSocketError(QAbstractSocket::SocketError error)
 
 void TwitchChatClient::onDataReceived()
 {
-    QByteArray data = m_socket->readAll();
-    QString message = QString::fromUtf8(data);
+    processData(m_socket->readAll());
+}
 
-    QStringList lines = message.split("\r\n", Qt::SkipEmptyParts);
-    for (const QString& line : lines) {
-        parseIrcMessage(line);
+void TwitchChatClient::processData(const QByteArray& data)
+{
+    // A read can end mid-line, keep the tail until the rest arrives
+    m_readBuffer += data;
+
+    qsizetype start = 0;
+    qsizetype end;
+    while ((end = m_readBuffer.indexOf("\r\n", start)) != -1) {
+        if (end > start) {
+            parseIrcMessage(QString::fromUtf8(m_readBuffer.constData() + start, end - start));
+        }
+        start = end + 2;
     }
+    m_readBuffer.remove(0, start);
 }
 
 void TwitchChatClient::sendPing()
@@ -0,0 +1,225 @@
+#include "win32hotkeybackend.h"
+#include "keytable.h"
+#include <QDebug>
+
+Win32HotkeyBackend* Win32HotkeyBackend::s_instance = nullptr;
+
+namespace {
+
+// Virtual key codes for the unshifted keys in KeyTable::keys
+constexpr auto virtualKeys = KeyTable::sorted(std::to_array<KeyTable::NativeKey>({
+    { Qt::Key_Space, VK_SPACE },
+    { Qt::Key_Return, VK_RETURN },
+    { Qt::Key_Tab, VK_TAB },
+    { Qt::Key_Escape, VK_ESCAPE },
+    { Qt::Key_Backspace, VK_BACK },
+    { Qt::Key_Delete, VK_DELETE },
+    { Qt::Key_Insert, VK_INSERT },
+    { Qt::Key_Home, VK_HOME },
+    { Qt::Key_End, VK_END },
+    { Qt::Key_PageUp, VK_PRIOR },
+    { Qt::Key_PageDown, VK_NEXT },
+    { Qt::Key_Left, VK_LEFT },
+    { Qt::Key_Right, VK_RIGHT },
+    { Qt::Key_Up, VK_UP },
+    { Qt::Key_Down, VK_DOWN },
+
+    // Function keys
+    { Qt::Key_F1, VK_F1 },
+    { Qt::Key_F2, VK_F2 },
+    { Qt::Key_F3, VK_F3 },
+    { Qt::Key_F4, VK_F4 },
+    { Qt::Key_F5, VK_F5 },
+    { Qt::Key_F6, VK_F6 },
+    { Qt::Key_F7, VK_F7 },
+    { Qt::Key_F8, VK_F8 },
+    { Qt::Key_F9, VK_F9 },
+    { Qt::Key_F10, VK_F10 },
+    { Qt::Key_F11, VK_F11 },
+    { Qt::Key_F12, VK_F12 },
+
+    // Other symbols
+    { Qt::Key_Minus, VK_OEM_MINUS },
+    { Qt::Key_Equal, VK_OEM_PLUS },
+    { Qt::Key_BracketLeft, VK_OEM_4 },
+    { Qt::Key_BracketRight, VK_OEM_6 },
+    { Qt::Key_Backslash, VK_OEM_5 },
+    { Qt::Key_Semicolon, VK_OEM_1 },
+    { Qt::Key_Apostrophe, VK_OEM_7 },
+    { Qt::Key_Comma, VK_OEM_COMMA },
+    { Qt::Key_Period, VK_OEM_PERIOD },
+    { Qt::Key_Slash, VK_OEM_2 },
+    { Qt::Key_QuoteLeft, VK_OEM_3 },
+}));
+
+INPUT keyInput(UINT vkCode, bool release)
+{
+    INPUT input = {};
+    input.type = INPUT_KEYBOARD;
+    input.ki.wVk = static_cast<WORD>(vkCode);
+    input.ki.dwFlags = release ? KEYEVENTF_KEYUP : 0;
+    return input;
+}
+
+} // namespace
+
+Win32HotkeyBackend::Win32HotkeyBackend(QObject *parent)
+    : HotkeyBackend(parent)
+    , m_keyboardHook(nullptr)
+    , m_modifiers(0)
+{
+    s_instance = this;
+}
+
+Win32HotkeyBackend::~Win32HotkeyBackend()
+{
+    uninstallHook();
+    if (s_instance == this) {
+        s_instance = nullptr;
+    }
+}
+
+bool Win32HotkeyBackend::registerHotkey(int modifiers, int key)
+{
+    UINT vkCode = qtKeyToVirtualKey(key);
+    if (vkCode == 0) {
+        qWarning() << "No virtual key for Qt key" << key;
+        return false;
+    }
+
+    m_hotkeys.append({ modifiers, key, vkCode });
+    installHook();
+    return m_keyboardHook != nullptr;
+}
+
+void Win32HotkeyBackend::unregisterAll()
+{
+    m_hotkeys.clear();
+    uninstallHook();
+}
+
+void Win32HotkeyBackend::installHook()
+{
+    if (m_keyboardHook) {
+        return;
+    }
+
+    m_keyboardHook = SetWindowsHookEx(
+        WH_KEYBOARD_LL,
+        lowLevelKeyboardProc,
+        GetModuleHandle(nullptr),
+        0
+        );
+
+    if (!m_keyboardHook) {
+        qWarning() << "Failed to install keyboard hook";
+    }
+}
+
+void Win32HotkeyBackend::uninstallHook()
+{
+    if (m_keyboardHook) {
+        UnhookWindowsHookEx(m_keyboardHook);
+        m_keyboardHook = nullptr;
+    }
+    m_modifiers = 0;
+}
+
+LRESULT CALLBACK Win32HotkeyBackend::lowLevelKeyboardProc(int nCode, WPARAM wParam, LPARAM lParam)
+{
+    if (nCode >= 0 && s_instance) {
+        KBDLLHOOKSTRUCT* pKeyBoard = (KBDLLHOOKSTRUCT*)lParam;
+
+        if (wParam == WM_KEYDOWN || wParam == WM_SYSKEYDOWN) {
+            if (s_instance->processKeyDown(pKeyBoard->vkCode)) {
+                // Consume the key event by returning 1
+                return 1;
+            }
+        } else if (wParam == WM_KEYUP || wParam == WM_SYSKEYUP) {
+            s_instance->updateModifier(pKeyBoard->vkCode, false);
+        }
+    }
+
+    return CallNextHookEx(nullptr, nCode, wParam, lParam);
+}
+
+void Win32HotkeyBackend::updateModifier(UINT vkCode, bool pressed)
+{
+    int modifier = 0;
+    switch (vkCode) {
+    case VK_LCONTROL:
+    case VK_RCONTROL:
+        modifier = Qt::ControlModifier;
+        break;
+    case VK_LSHIFT:
+    case VK_RSHIFT:
+        modifier = Qt::ShiftModifier;
+        break;
+    case VK_LMENU:
+    case VK_RMENU:
+        modifier = Qt::AltModifier;
+        break;
+    default:
+        return;
+    }
+
+    if (pressed) {
+        m_modifiers |= modifier;
+    } else {
+        m_modifiers &= ~modifier;
+    }
+}
+
+bool Win32HotkeyBackend::processKeyDown(UINT vkCode)
+{
+    int before = m_modifiers;
+    updateModifier(vkCode, true);
+    if (m_modifiers != before) {
+        return false;
+    }
+
+    for (const Hotkey& hotkey : std::as_const(m_hotkeys)) {
+        if (hotkey.vkCode == vkCode && hotkey.modifiers == m_modifiers) {
+            emit hotkeyActivated(hotkey.modifiers, hotkey.key);
+            return true;
+        }
+    }
+    return false;
+}
+
+UINT Win32HotkeyBackend::qtKeyToVirtualKey(int qtKey)
+{
+    int key = KeyTable::baseKey(qtKey);
+    if ((key >= Qt::Key_A && key <= Qt::Key_Z) || (key >= Qt::Key_0 && key <= Qt::Key_9)) {
+        // Letters and digits share their ASCII code with the virtual key
+        return static_cast<UINT>(key);
+    }
+    const KeyTable::NativeKey* native = KeyTable::find(virtualKeys, key);
+    return native ? native->code : 0;
+}
+
+bool Win32HotkeyBackend::sendShortcut(int modifiers, int key)
+{
+    INPUT inputs[8];
+    int inputCount = 0;
+
+    // Press modifiers first
+    if (modifiers & Qt::ControlModifier) inputs[inputCount++] = keyInput(VK_CONTROL, false);
+    if (modifiers & Qt::ShiftModifier) inputs[inputCount++] = keyInput(VK_SHIFT, false);
+    if (modifiers & Qt::AltModifier) inputs[inputCount++] = keyInput(VK_MENU, false);
+
+    // Press and release the main key
+    UINT vkCode = qtKeyToVirtualKey(key);
+    if (vkCode != 0) {
+        inputs[inputCount++] = keyInput(vkCode, false);
+        inputs[inputCount++] = keyInput(vkCode, true);
+    }
+
+    // Release modifiers in reverse order
+    if (modifiers & Qt::AltModifier) inputs[inputCount++] = keyInput(VK_MENU, true);
+    if (modifiers & Qt::ShiftModifier) inputs[inputCount++] = keyInput(VK_SHIFT, true);
+    if (modifiers & Qt::ControlModifier) inputs[inputCount++] = keyInput(VK_CONTROL, true);
+
+    // Send the input events
+    return SendInput(inputCount, inputs, sizeof(INPUT)) == static_cast<UINT>(inputCount);
+}
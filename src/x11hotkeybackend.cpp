@@ -0,0 +1,224 @@
+#include "x11hotkeybackend.h"
+#include "keytable.h"
+#include <QDebug>
+#include <QGuiApplication>
+#include <QtGui/qguiapplication_platform.h>
+
+#include <X11/Xlib.h>
+#include <X11/keysym.h>
+#include <xcb/xcb.h>
+#include <cstdlib>
+
+namespace {
+
+// Keysyms for the unshifted keys in KeyTable::keys, printable ASCII keys share
+// their code with the keysym and don't need an entry
+constexpr auto keysyms = KeyTable::sorted(std::to_array<KeyTable::NativeKey>({
+    { Qt::Key_Return, XK_Return },
+    { Qt::Key_Enter, XK_KP_Enter },
+    { Qt::Key_Tab, XK_Tab },
+    { Qt::Key_Escape, XK_Escape },
+    { Qt::Key_Backspace, XK_BackSpace },
+    { Qt::Key_Delete, XK_Delete },
+    { Qt::Key_Insert, XK_Insert },
+    { Qt::Key_Home, XK_Home },
+    { Qt::Key_End, XK_End },
+    { Qt::Key_PageUp, XK_Prior },
+    { Qt::Key_PageDown, XK_Next },
+    { Qt::Key_Left, XK_Left },
+    { Qt::Key_Right, XK_Right },
+    { Qt::Key_Up, XK_Up },
+    { Qt::Key_Down, XK_Down },
+
+    // Function keys
+    { Qt::Key_F1, XK_F1 },
+    { Qt::Key_F2, XK_F2 },
+    { Qt::Key_F3, XK_F3 },
+    { Qt::Key_F4, XK_F4 },
+    { Qt::Key_F5, XK_F5 },
+    { Qt::Key_F6, XK_F6 },
+    { Qt::Key_F7, XK_F7 },
+    { Qt::Key_F8, XK_F8 },
+    { Qt::Key_F9, XK_F9 },
+    { Qt::Key_F10, XK_F10 },
+    { Qt::Key_F11, XK_F11 },
+    { Qt::Key_F12, XK_F12 },
+}));
+
+// Lock modifiers the user may have toggled, each grab is repeated for all of them
+constexpr unsigned int lockMasks[] = { 0, LockMask, Mod2Mask, LockMask | Mod2Mask };
+constexpr unsigned int relevantMasks = ControlMask | ShiftMask | Mod1Mask | Mod4Mask;
+
+Display* x11Display()
+{
+    auto *x11App = qGuiApp ? qGuiApp->nativeInterface<QNativeInterface::QX11Application>() : nullptr;
+    return x11App ? x11App->display() : nullptr;
+}
+
+xcb_connection_t* x11Connection()
+{
+    auto *x11App = qGuiApp ? qGuiApp->nativeInterface<QNativeInterface::QX11Application>() : nullptr;
+    return x11App ? x11App->connection() : nullptr;
+}
+
+// Root window of the default screen, read from the xcb connection setup
+xcb_window_t rootWindow(xcb_connection_t *connection, Display *display)
+{
+    xcb_screen_iterator_t screens = xcb_setup_roots_iterator(xcb_get_setup(connection));
+    for (int screen = DefaultScreen(display); screen > 0 && screens.rem > 1; --screen) {
+        xcb_screen_next(&screens);
+    }
+    return screens.data->root;
+}
+
+KeySym qtKeyToKeysym(int qtKey)
+{
+    int key = KeyTable::baseKey(qtKey);
+    if (key >= Qt::Key_A && key <= Qt::Key_Z) {
+        // Grab the lowercase keysym, shift is part of the modifiers
+        return XK_a + (key - Qt::Key_A);
+    }
+    if (const KeyTable::NativeKey* native = KeyTable::find(keysyms, key)) {
+        return native->code;
+    }
+    if (key >= Qt::Key_Space && key <= Qt::Key_AsciiTilde) {
+        return static_cast<KeySym>(key);
+    }
+    return NoSymbol;
+}
+
+unsigned int qtModifiersToX11(int modifiers)
+{
+    unsigned int mask = 0;
+    if (modifiers & Qt::ControlModifier) mask |= ControlMask;
+    if (modifiers & Qt::ShiftModifier) mask |= ShiftMask;
+    if (modifiers & Qt::AltModifier) mask |= Mod1Mask;
+    if (modifiers & Qt::MetaModifier) mask |= Mod4Mask;
+    return mask;
+}
+
+} // namespace
+
+X11HotkeyBackend::X11HotkeyBackend(QObject *parent)
+    : HotkeyBackend(parent)
+{
+    QCoreApplication::instance()->installNativeEventFilter(this);
+}
+
+X11HotkeyBackend::~X11HotkeyBackend()
+{
+    unregisterAll();
+    if (QCoreApplication::instance()) {
+        QCoreApplication::instance()->removeNativeEventFilter(this);
+    }
+}
+
+bool X11HotkeyBackend::isAvailable()
+{
+    // Grabs go through xcb, keysyms are mapped to keycodes with Xlib, so a Qt
+    // built without xcb-xlib has no Display and can't use this backend
+    return x11Connection() != nullptr && x11Display() != nullptr;
+}
+
+bool X11HotkeyBackend::registerHotkey(int modifiers, int key)
+{
+    Display *display = x11Display();
+    if (!display) {
+        return false;
+    }
+
+    KeySym keysym = qtKeyToKeysym(key);
+    KeyCode keycode = keysym != NoSymbol ? XKeysymToKeycode(display, keysym) : 0;
+    if (keycode == 0) {
+        qWarning() << "No X11 keycode for Qt key" << key;
+        return false;
+    }
+
+    Hotkey hotkey{ modifiers, key, keycode, qtModifiersToX11(modifiers) };
+    if (!grab(hotkey)) {
+        return false;
+    }
+    m_hotkeys.append(hotkey);
+    return true;
+}
+
+void X11HotkeyBackend::unregisterAll()
+{
+    for (const Hotkey &hotkey : std::as_const(m_hotkeys)) {
+        ungrab(hotkey);
+    }
+    m_hotkeys.clear();
+}
+
+bool X11HotkeyBackend::grab(const Hotkey &hotkey)
+{
+    Display *display = x11Display();
+    xcb_connection_t *connection = x11Connection();
+    if (!display || !connection) {
+        return false;
+    }
+
+    // Grabs are checked requests: a combination held by another client fails
+    // with BadAccess, which Qt would otherwise swallow
+    xcb_window_t root = rootWindow(connection, display);
+    xcb_void_cookie_t cookies[std::size(lockMasks)];
+    for (std::size_t i = 0; i < std::size(lockMasks); ++i) {
+        cookies[i] = xcb_grab_key_checked(connection, 1, root, hotkey.nativeModifiers | lockMasks[i],
+                                          hotkey.keycode, XCB_GRAB_MODE_ASYNC, XCB_GRAB_MODE_ASYNC);
+    }
+
+    bool grabbed = true;
+    for (xcb_void_cookie_t cookie : cookies) {
+        if (xcb_generic_error_t *error = xcb_request_check(connection, cookie)) {
+            if (grabbed) {
+                qWarning() << "Key combination is already grabbed by another client, X11 error" << error->error_code;
+            }
+            grabbed = false;
+            free(error);
+        }
+    }
+
+    if (!grabbed) {
+        ungrab(hotkey);
+    }
+    return grabbed;
+}
+
+void X11HotkeyBackend::ungrab(const Hotkey &hotkey)
+{
+    Display *display = x11Display();
+    xcb_connection_t *connection = x11Connection();
+    if (!display || !connection) {
+        return;
+    }
+
+    xcb_window_t root = rootWindow(connection, display);
+    for (unsigned int lockMask : lockMasks) {
+        xcb_ungrab_key(connection, hotkey.keycode, root, hotkey.nativeModifiers | lockMask);
+    }
+    xcb_flush(connection);
+}
+
+bool X11HotkeyBackend::nativeEventFilter(const QByteArray &eventType, void *message, qintptr *result)
+{
+    Q_UNUSED(result)
+
+    if (eventType != "xcb_generic_event_t") {
+        return false;
+    }
+
+    auto *event = static_cast<xcb_generic_event_t *>(message);
+    if ((event->response_type & ~0x80) != XCB_KEY_PRESS) {
+        return false;
+    }
+
+    auto *keyPress = reinterpret_cast<xcb_key_press_event_t *>(event);
+    unsigned int state = keyPress->state & relevantMasks;
+    for (const Hotkey &hotkey : std::as_const(m_hotkeys)) {
+        if (hotkey.keycode == keyPress->detail && hotkey.nativeModifiers == state) {
+            emit hotkeyActivated(hotkey.modifiers, hotkey.key);
+            return true;
+        }
+    }
+    return false;
+}
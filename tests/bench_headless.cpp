@@ -0,0 +1,167 @@
+#include "chatmessagemodel.h"
+#include "chatrelay.h"
+#include "twitchchatclient.h"
+#include <QLoggingCategory>
+#include <QQmlComponent>
+#include <QQmlEngine>
+#include <QQuickItem>
+#include <QQuickView>
+#include <QSignalSpy>
+#include <QTest>
+#include <QtQuickTest/quicktest.h>
+#include <memory>
+
+// Same batch of PRIVMSG lines through the headless relay and through the
+// overlay's model, its real delegate and a rendered frame. Build and run by
+// hand, it is not registered with ctest.
+class BenchHeadless : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void headlessRelay_data();
+    void headlessRelay();
+    void qmlModel();
+
+private:
+    QByteArray m_batch;
+};
+
+static constexpr int BatchSize = 1000;
+
+void BenchHeadless::initTestCase()
+{
+    // Headless mode runs with debug output off, the client logs every raw line otherwise
+    QLoggingCategory::setFilterRules("*.debug=false");
+
+    for (int i = 0; i < BatchSize; ++i) {
+        m_batch += QString("@badge-info=;badges=subscriber/12;color=#1E90FF;display-name=Viewer%1;emotes=;"
+                           "first-msg=0;id=6b2c6c4e-%1;mod=0;room-id=12345;subscriber=1;tmi-sent-ts=1700000000000;"
+                           "turbo=0;user-id=%1;user-type= :viewer%1!viewer%1@viewer%1.tmi.twitch.tv "
+                           "PRIVMSG #channel :message number %1 with some typical chat text in it\r\n")
+                       .arg(i)
+                       .toUtf8();
+    }
+}
+
+void BenchHeadless::headlessRelay_data()
+{
+    QTest::addColumn<int>("format");
+    QTest::newRow("json") << int(ChatRelay::Json);
+    QTest::newRow("cbor") << int(ChatRelay::Cbor);
+}
+
+void BenchHeadless::headlessRelay()
+{
+    QFETCH(int, format);
+
+    TwitchChatClient* client = TwitchChatClient::instance();
+    QObject context;
+    qint64 bytes = 0;
+    int messages = 0;
+    connect(client, &TwitchChatClient::messageReceived, &context,
+            [&](const QString& username, const QString& message, const QString& color) {
+        bytes += ChatRelay::encode(ChatRelay::Format(format), username, message, color, 0).size();
+        ++messages;
+    });
+
+    QBENCHMARK {
+        client->processData(m_batch);
+    }
+
+    QVERIFY(messages >= BatchSize);
+    QVERIFY(bytes > 0);
+}
+
+void BenchHeadless::qmlModel()
+{
+    TwitchChatClient* client = TwitchChatClient::instance();
+
+    qmlRegisterType<ChatMessageModel>("Bench", 1, 0, "ChatMessageModel");
+    qmlRegisterSingletonInstance("Bench", 1, 0, "TwitchChatClient", client);
+
+    // The overlay renders with the software backend, see main.cpp
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::Software);
+    QQuickView view;
+    view.resize(400, 600);
+
+    // Mirrors the chat list in Main.qml, the delegate is loaded from the qml directory
+    QQmlComponent component(view.engine());
+    component.setData(R"(
+        import QtQuick
+        import Bench
+
+        Item {
+            width: 400
+            height: 600
+
+            ChatMessageModel {
+                id: chatModel
+                maxMessages: 100
+            }
+
+            ListView {
+                id: chatView
+                objectName: "chatView"
+                anchors.fill: parent
+                model: chatModel
+                spacing: 2
+
+                delegate: ChatMessageDelegate {
+                    width: chatView.width
+                    now: chatModel.now
+                    fadeDuration: chatModel.fadeDuration
+                }
+
+                onCountChanged: Qt.callLater(positionViewAtEnd)
+            }
+
+            Connections {
+                target: TwitchChatClient
+
+                function onMessageReceived(username, message, color) {
+                    chatModel.append(username, message, color)
+                }
+            }
+        }
+    )", QUrl::fromLocalFile(QStringLiteral(OVERLAY_QML_DIR "/BenchChatList.qml")));
+
+    std::unique_ptr<QQuickItem> root(qobject_cast<QQuickItem*>(component.create()));
+    QVERIFY2(root, qPrintable(component.errorString()));
+    root->setParentItem(view.contentItem());
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    QSignalSpy frames(&view, &QQuickWindow::frameSwapped);
+    QBENCHMARK {
+        frames.clear();
+        client->processData(m_batch);
+        // Each round ends once the ListView has laid out its delegates and a frame is out
+        QVERIFY(QQuickTest::qWaitForPolish(&view));
+        QTRY_VERIFY(!frames.isEmpty());
+    }
+
+    auto* model = root->findChild<ChatMessageModel*>();
+    QVERIFY(model);
+    QCOMPARE(model->rowCount(), 100);
+
+    auto* listView = root->findChild<QQuickItem*>("chatView");
+    QVERIFY(listView);
+    QQuickItem* last = nullptr;
+    QMetaObject::invokeMethod(listView, "itemAtIndex", Q_RETURN_ARG(QQuickItem*, last), Q_ARG(int, 99));
+    QVERIFY2(last, "the last row has no delegate");
+
+    // Nothing is fading yet, so an idle overlay must not keep producing frames
+    model->setLifetime(60);
+    model->setFadeDuration(1000);
+    frames.clear();
+    model->append("viewer", "last message", "#1E90FF");
+    QTRY_VERIFY(!frames.isEmpty());
+    frames.clear();
+    QTest::qWait(1000);
+    QCOMPARE(frames.count(), 0);
+}
+
+QTEST_MAIN(BenchHeadless)
+#include "bench_headless.moc"
@@ -0,0 +1,228 @@
+#include "chatserver.h"
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTcpSocket>
+#include <QTest>
+#include <memory>
+#include <vector>
+
+// Reads the /events stream and checks that events arrive complete and in order
+class EventReader : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit EventReader(QTcpSocket* socket)
+        : m_socket(socket)
+    {
+        connect(m_socket, &QTcpSocket::readyRead, this, &EventReader::onReadyRead);
+    }
+
+    int received = 0;
+    bool inOrder = true;
+    bool headerSeen = false;
+
+private slots:
+    void onReadyRead()
+    {
+        m_buffer += m_socket->readAll();
+
+        if (!headerSeen) {
+            qsizetype headerEnd = m_buffer.indexOf("\r\n\r\n");
+            if (headerEnd == -1) {
+                return;
+            }
+            headerSeen = m_buffer.startsWith("HTTP/1.1 200 OK");
+            m_buffer.remove(0, headerEnd + 4);
+        }
+
+        // Each event is "data: <json>\n\n"
+        qsizetype end;
+        while ((end = m_buffer.indexOf("\n\n")) != -1) {
+            QByteArray block = m_buffer.left(end);
+            m_buffer.remove(0, end + 2);
+
+            QJsonObject event = QJsonDocument::fromJson(block.mid(qstrlen("data: "))).object();
+            if (event.value("username").toString() != QString::number(received)) {
+                inOrder = false;
+            }
+            ++received;
+        }
+    }
+
+private:
+    QTcpSocket* m_socket;
+    QByteArray m_buffer;
+};
+
+class TestChatServer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void slowClientDoesNotStallOthers();
+    void rejectsUnknownPaths();
+    void checksHostHeader_data();
+    void checksHostHeader();
+    void ignoresQueryString();
+
+private:
+    // An empty host sends localhost:<port>, what OBS sends for the page URL
+    QTcpSocket* connectClient(const QByteArray& path, const QByteArray& host = QByteArray());
+    QByteArray readResponse(QTcpSocket* socket);
+
+    ChatServer* m_server = nullptr;
+};
+
+static constexpr int ReaderCount = 50;
+
+void TestChatServer::initTestCase()
+{
+    m_server = ChatServer::instance();
+    QVERIFY(m_server->start(0));
+    QVERIFY(m_server->port() > 0);
+}
+
+void TestChatServer::cleanupTestCase()
+{
+    m_server->stop();
+}
+
+QTcpSocket* TestChatServer::connectClient(const QByteArray& path, const QByteArray& host)
+{
+    auto* socket = new QTcpSocket(this);
+    socket->connectToHost(QHostAddress::LocalHost, m_server->port());
+    if (!socket->waitForConnected(5000)) {
+        return nullptr;
+    }
+    QByteArray hostHeader = host.isEmpty() ? "localhost:" + QByteArray::number(m_server->port()) : host;
+    socket->write("GET " + path + " HTTP/1.1\r\nHost: " + hostHeader + "\r\n\r\n");
+    return socket;
+}
+
+QByteArray TestChatServer::readResponse(QTcpSocket* socket)
+{
+    // Wait for the end of the headers, a subscriber stays connected after them
+    QByteArray response;
+    for (int i = 0; i < 50 && !response.contains("\r\n\r\n"); ++i) {
+        if (socket->bytesAvailable() == 0 && !socket->waitForReadyRead(100)) {
+            continue;
+        }
+        response += socket->readAll();
+    }
+    return response;
+}
+
+void TestChatServer::slowClientDoesNotStallOthers()
+{
+    std::vector<std::unique_ptr<EventReader>> readers;
+    QList<QTcpSocket*> sockets;
+    for (int i = 0; i < ReaderCount; ++i) {
+        QTcpSocket* socket = connectClient("/events");
+        QVERIFY(socket);
+        sockets.append(socket);
+        readers.push_back(std::make_unique<EventReader>(socket));
+    }
+
+    // Never reads: Qt stops pulling from the kernel once its one byte buffer is full
+    QTcpSocket* slow = connectClient("/events");
+    QVERIFY(slow);
+    slow->setReadBufferSize(1);
+    slow->setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, 4096);
+
+    QTRY_COMPARE_WITH_TIMEOUT(m_server->clientCount(), ReaderCount + 1, 10000);
+
+    // Large events so the slow client's kernel buffers fill in a reasonable number of rounds
+    const QString padding(4096, QChar('x'));
+    int sent = 0;
+    auto sendRound = [&]() {
+        for (int i = 0; i < 32; ++i, ++sent) {
+            m_server->broadcastMessage(QString::number(sent), padding, "#FFFFFF");
+        }
+        // Every reading client keeps up with every round
+        for (const auto& reader : readers) {
+            QTRY_COMPARE_WITH_TIMEOUT(reader->received, sent, 10000);
+        }
+    };
+
+    while (m_server->longestQueue() < ChatServer::MaxQueuedEvents && sent < 20000) {
+        sendRound();
+        if (QTest::currentTestFailed()) {
+            return;
+        }
+    }
+    QCOMPARE(m_server->longestQueue(), ChatServer::MaxQueuedEvents);
+
+    // Keep pushing past the limit, the slow queue stays bounded and only it drops
+    qint64 droppedBefore = m_server->droppedEvents();
+    for (int round = 0; round < 16; ++round) {
+        sendRound();
+        if (QTest::currentTestFailed()) {
+            return;
+        }
+        QCOMPARE(m_server->longestQueue(), ChatServer::MaxQueuedEvents);
+    }
+    QVERIFY(m_server->droppedEvents() > droppedBefore);
+
+    for (const auto& reader : readers) {
+        QVERIFY(reader->headerSeen);
+        QVERIFY(reader->inOrder);
+        QCOMPARE(reader->received, sent);
+    }
+
+    slow->abort();
+    for (QTcpSocket* socket : std::as_const(sockets)) {
+        socket->abort();
+    }
+    QTRY_COMPARE(m_server->clientCount(), 0);
+    readers.clear();
+    qDeleteAll(sockets);
+    delete slow;
+}
+
+void TestChatServer::rejectsUnknownPaths()
+{
+    QTcpSocket* socket = connectClient("/nope");
+    QVERIFY(socket);
+    QTRY_VERIFY(socket->state() == QAbstractSocket::UnconnectedState || socket->bytesAvailable() > 0);
+    QVERIFY(socket->readAll().startsWith("HTTP/1.1 404"));
+    delete socket;
+}
+
+void TestChatServer::checksHostHeader_data()
+{
+    const QByteArray port = QByteArray::number(ChatServer::instance()->port());
+    QTest::addColumn<QByteArray>("host");
+    QTest::addColumn<QByteArray>("status");
+    QTest::newRow("localhost") << "localhost:" + port << QByteArray("HTTP/1.1 200");
+    QTest::newRow("loopback") << "127.0.0.1:" + port << QByteArray("HTTP/1.1 200");
+    QTest::newRow("rebound name") << "attacker.example:" + port << QByteArray("HTTP/1.1 403");
+    QTest::newRow("other port") << QByteArray("localhost:1") << QByteArray("HTTP/1.1 403");
+    QTest::newRow("no port") << QByteArray("localhost") << QByteArray("HTTP/1.1 403");
+}
+
+void TestChatServer::checksHostHeader()
+{
+    QFETCH(QByteArray, host);
+    QFETCH(QByteArray, status);
+
+    QTcpSocket* socket = connectClient("/", host);
+    QVERIFY(socket);
+    QVERIFY(readResponse(socket).startsWith(status));
+    delete socket;
+}
+
+void TestChatServer::ignoresQueryString()
+{
+    QTcpSocket* socket = connectClient("/events?obs=1");
+    QVERIFY(socket);
+    QByteArray response = readResponse(socket);
+    QVERIFY(response.startsWith("HTTP/1.1 200"));
+    QVERIFY(response.contains("Content-Type: text/event-stream"));
+    delete socket;
+}
+
+QTEST_GUILESS_MAIN(TestChatServer)
+#include "tst_chatserver.moc"
@@ -0,0 +1,88 @@
+#include "mockhotkeybackend.h"
+#include "shortcutmanager.h"
+#include <QSignalSpy>
+#include <QTest>
+
+class TestShortcutManager : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void registersDefaultToggle();
+    void toggleShortcutEmitsToggleOverlay();
+    void otherCombinationsAreIgnored();
+    void unregisterShortcuts();
+    void releasesBackendOnDestruction();
+    void shortcutText();
+};
+
+void TestShortcutManager::registersDefaultToggle()
+{
+    auto *backend = new MockHotkeyBackend;
+    ShortcutManager manager(backend);
+
+    QCOMPARE(manager.backend(), backend);
+    QVERIFY(backend->registeredHotkeys().contains(qMakePair(int(Qt::ControlModifier | Qt::ShiftModifier), int(Qt::Key_T))));
+}
+
+void TestShortcutManager::toggleShortcutEmitsToggleOverlay()
+{
+    auto *backend = new MockHotkeyBackend;
+    ShortcutManager manager(backend);
+    QSignalSpy spy(&manager, &ShortcutManager::toggleOverlay);
+
+    QVERIFY(backend->trigger(Qt::ControlModifier | Qt::ShiftModifier, Qt::Key_T));
+    QCOMPARE(spy.count(), 1);
+}
+
+void TestShortcutManager::otherCombinationsAreIgnored()
+{
+    auto *backend = new MockHotkeyBackend;
+    ShortcutManager manager(backend);
+    QSignalSpy spy(&manager, &ShortcutManager::toggleOverlay);
+
+    QVERIFY(!backend->trigger(Qt::ControlModifier, Qt::Key_T));
+    QVERIFY(!backend->trigger(Qt::ControlModifier | Qt::ShiftModifier | Qt::AltModifier, Qt::Key_T));
+    QVERIFY(!backend->trigger(Qt::ControlModifier | Qt::ShiftModifier, Qt::Key_Y));
+
+    // Even if a backend reports an unexpected combination, only the toggle one counts
+    emit backend->hotkeyActivated(Qt::ShiftModifier, Qt::Key_T);
+    QCOMPARE(spy.count(), 0);
+}
+
+void TestShortcutManager::unregisterShortcuts()
+{
+    auto *backend = new MockHotkeyBackend;
+    ShortcutManager manager(backend);
+    QSignalSpy spy(&manager, &ShortcutManager::toggleOverlay);
+
+    manager.unregisterShortcuts();
+    QVERIFY(backend->registeredHotkeys().isEmpty());
+    QVERIFY(!backend->trigger(Qt::ControlModifier | Qt::ShiftModifier, Qt::Key_T));
+    QCOMPARE(spy.count(), 0);
+}
+
+void TestShortcutManager::releasesBackendOnDestruction()
+{
+    auto *backend = new MockHotkeyBackend;
+    QSignalSpy spy(backend, &QObject::destroyed);
+    {
+        ShortcutManager manager(backend);
+        QCOMPARE(ShortcutManager::instance(), &manager);
+    }
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(ShortcutManager::instance(), nullptr);
+}
+
+void TestShortcutManager::shortcutText()
+{
+    auto *backend = new MockHotkeyBackend;
+    ShortcutManager manager(backend);
+
+    QCOMPARE(manager.getShortcutText(Qt::ControlModifier | Qt::ShiftModifier, Qt::Key_T), QString("Ctrl+Shift+T"));
+    QCOMPARE(manager.getShortcutText(Qt::AltModifier, Qt::Key_Exclam), QString("Alt+1"));
+    QCOMPARE(manager.getShortcutText(Qt::ControlModifier, Qt::Key_PageUp), QString("Ctrl+Page Up"));
+}
+
+QTEST_GUILESS_MAIN(TestShortcutManager)
+#include "tst_shortcutmanager.moc"
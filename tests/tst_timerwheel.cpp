@@ -0,0 +1,177 @@
+#include "timerwheel.h"
+#include <QRandomGenerator>
+#include <QTest>
+#include <map>
+
+class TestTimerWheel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void expiresOnItsTick();
+    void pastDeadlineExpiresOnNextTick();
+    void cascadesAcrossLevels_data();
+    void cascadesAcrossLevels();
+    void parksDeadlinesBeyondRange();
+    void cancelRemovesEntry();
+    void nextDeadlineIsALowerBound();
+    void randomizedDeadlines();
+};
+
+static constexpr qint64 TickMs = 50;
+// Three levels of 64 slots
+static constexpr qint64 RangeTicks = 64 * 64 * 64;
+
+void TestTimerWheel::expiresOnItsTick()
+{
+    TimerWheel wheel(TickMs);
+    wheel.schedule(1, 120);
+
+    // Rounded up to the 150 ms tick, never early
+    QVERIFY(wheel.advance(100).isEmpty());
+    QVERIFY(wheel.advance(149).isEmpty());
+    QCOMPARE(wheel.advance(150), QList<quint64>{ 1 });
+    QVERIFY(wheel.isEmpty());
+}
+
+void TestTimerWheel::pastDeadlineExpiresOnNextTick()
+{
+    TimerWheel wheel(TickMs);
+    QVERIFY(wheel.advance(1000).isEmpty());
+
+    wheel.schedule(1, 500);
+    QVERIFY(wheel.advance(1000).isEmpty());
+    QCOMPARE(wheel.advance(1050), QList<quint64>{ 1 });
+}
+
+void TestTimerWheel::cascadesAcrossLevels_data()
+{
+    QTest::addColumn<qint64>("startTick");
+    QTest::addColumn<qint64>("deltaTicks");
+
+    QTest::newRow("level 0") << qint64(0) << qint64(63);
+    QTest::newRow("level 1 lower edge") << qint64(0) << qint64(64);
+    QTest::newRow("level 1 upper edge") << qint64(63) << qint64(4095);
+    QTest::newRow("level 1 across wrap") << qint64(4000) << qint64(200);
+    QTest::newRow("level 2 lower edge") << qint64(0) << qint64(4096);
+    QTest::newRow("level 2 boundary deadline") << qint64(1) << qint64(4095 + 4096);
+    QTest::newRow("level 2 upper edge") << qint64(4095) << qint64(RangeTicks - 1);
+    QTest::newRow("level 2 across wrap") << qint64(RangeTicks - 10) << qint64(5000);
+}
+
+void TestTimerWheel::cascadesAcrossLevels()
+{
+    QFETCH(qint64, startTick);
+    QFETCH(qint64, deltaTicks);
+
+    TimerWheel wheel(TickMs);
+    wheel.advance(startTick * TickMs);
+
+    qint64 deadline = (startTick + deltaTicks) * TickMs;
+    wheel.schedule(7, deadline);
+
+    QVERIFY(wheel.advance(deadline - 1).isEmpty());
+    QCOMPARE(wheel.advance(deadline), QList<quint64>{ 7 });
+    QVERIFY(wheel.isEmpty());
+}
+
+void TestTimerWheel::parksDeadlinesBeyondRange()
+{
+    TimerWheel wheel(TickMs);
+    wheel.advance(123 * TickMs);
+
+    // Several turns of the top level away, re-filed on each cascade
+    qint64 deadline = (123 + 3 * RangeTicks + 17) * TickMs;
+    wheel.schedule(9, deadline);
+
+    QVERIFY(wheel.advance(deadline - TickMs).isEmpty());
+    QCOMPARE(wheel.size(), qsizetype(1));
+    QCOMPARE(wheel.advance(deadline), QList<quint64>{ 9 });
+}
+
+void TestTimerWheel::cancelRemovesEntry()
+{
+    TimerWheel wheel(TickMs);
+    wheel.schedule(1, 1000);
+    wheel.schedule(2, 300 * 1000);
+    wheel.schedule(3, RangeTicks * TickMs * 2);
+    wheel.schedule(4, 1000);
+
+    QVERIFY(wheel.cancel(1, 1000));
+    QVERIFY(wheel.cancel(2, 300 * 1000));
+    QVERIFY(wheel.cancel(3, RangeTicks * TickMs * 2));
+    QVERIFY(!wheel.cancel(1, 1000));
+    QCOMPARE(wheel.size(), qsizetype(1));
+
+    QCOMPARE(wheel.advance(RangeTicks * TickMs * 3), QList<quint64>{ 4 });
+    QVERIFY(wheel.isEmpty());
+    QCOMPARE(wheel.nextDeadline(), qint64(-1));
+}
+
+void TestTimerWheel::nextDeadlineIsALowerBound()
+{
+    TimerWheel wheel(TickMs);
+    QCOMPARE(wheel.nextDeadline(), qint64(-1));
+
+    wheel.schedule(1, 2000);
+    QCOMPARE(wheel.nextDeadline(), qint64(2000));
+
+    // A far deadline wakes at its cascade at the latest, never after the deadline
+    TimerWheel far(TickMs);
+    far.schedule(2, 600 * 1000);
+    qint64 now = 0;
+    int wakeUps = 0;
+    while (!far.isEmpty()) {
+        qint64 next = far.nextDeadline();
+        QVERIFY(next > now);
+        QVERIFY(next <= 600 * 1000);
+        now = next;
+        far.advance(now);
+        ++wakeUps;
+    }
+    QCOMPARE(now, qint64(600 * 1000));
+    // One wake-up per level at most, not one per tick
+    QVERIFY(wakeUps <= 3);
+}
+
+void TestTimerWheel::randomizedDeadlines()
+{
+    QRandomGenerator random(1234);
+    TimerWheel wheel(TickMs);
+    std::map<quint64, qint64> pending;
+    qint64 now = 0;
+    quint64 nextId = 0;
+
+    for (int step = 0; step < 100000; ++step) {
+        if (random.bounded(3) == 0) {
+            qint64 range = step % 7 == 0 ? RangeTicks * TickMs * 2 : 300 * 1000;
+            qint64 deadline = now + random.bounded(range);
+            wheel.schedule(nextId, deadline);
+            pending[nextId++] = deadline;
+        }
+        if (random.bounded(5) == 0 && !pending.empty()) {
+            auto it = pending.begin();
+            std::advance(it, random.bounded(int(pending.size())));
+            QVERIFY(wheel.cancel(it->first, it->second));
+            pending.erase(it);
+        }
+
+        now += random.bounded(200);
+        const QList<quint64> expired = wheel.advance(now);
+        for (quint64 id : expired) {
+            auto it = pending.find(id);
+            QVERIFY(it != pending.end());
+            // Never early, late by less than one tick
+            QVERIFY(it->second <= now);
+            QVERIFY(now - it->second < TickMs + 200);
+            pending.erase(it);
+        }
+        QCOMPARE(wheel.size(), qsizetype(pending.size()));
+    }
+
+    wheel.advance(now + RangeTicks * TickMs * 3);
+    QVERIFY(wheel.isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestTimerWheel)
+#include "tst_timerwheel.moc"